@@ -0,0 +1,98 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Defs.hh>
+
+#include <fmt/core.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+/**
+ * Shared parts of the benchmarks, each one is an executable that prints
+ * what it measured. `cmake --build <dir> --target bench` runs them all with
+ * their default sizes, the numbers only mean something in a Release build.
+ * Every benchmark prints a checksum of its results so the work it times
+ * can not be optimized away, and so two variants can be seen to agree.
+ */
+namespace hive::ir::bench {
+
+// Best wall time in seconds of runs calls to fn
+template<typename Fn>
+auto best_of(size runs, Fn&& fn) -> double {
+	double best = 1e300;
+
+	for (size i = 0; i < runs; i++) {
+		auto start = std::chrono::steady_clock::now();
+		fn();
+		double took = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (took < best) best = took;
+	}
+	return best;
+}
+
+// argv[n] as a count, fallback when it is missing
+inline auto arg(int argc, char** argv, int n, size fallback) -> size {
+	return argc > n ? std::strtoull(argv[n], nullptr, 10) : fallback;
+}
+
+/**
+ * A machine generated module like the ones builds feed hir, labels of ten
+ * instructions that mix every operand layout. Averages close to six tokens
+ * per instruction.
+ */
+inline auto module(size instructions) -> std::string {
+	std::string text = "#version \"0.0.1\"\n#target linux_x64\n#syslink libc\n";
+	text.reserve(instructions * 24);
+
+	for (size i = 0; i < instructions; i++) {
+		size r = i % 60 + 1;
+
+		if (i % 10 == 0) text += fmt::format("\nLABEL label_{}:\n", i / 10);
+
+		switch (i % 10) {
+			case 0: text += fmt::format("\tADD r{}, r{} -> r{}\n", r, r + 1, r + 2); break;
+			case 1: text += fmt::format("\tSUBTRACT r{}, d{} -> r{}\n", r, r, r + 1); break;
+			case 2: text += fmt::format("\tNOT r{} -> r{}\n", r, r + 1); break;
+			case 3: text += fmt::format("\tMULTIPLY r{}, r{} -> r{}\n", r, r + 2, r + 3); break;
+			case 4: text += fmt::format("\tXOR r{}, r{} -> r{}\n", r, r + 1, r); break;
+			case 5: text += fmt::format("\tDEREF r{} -> r{}\n", r, r + 1); break;
+			case 6: text += fmt::format("\td{} STATIC \"string number {}\"\n", r, i); break;
+			case 7: text += fmt::format("\tCALL libc.printf d{} r{} r{}\n", r, r, r + 1); break;
+			case 8: text += fmt::format("\td{} STATIC 0x{:X}\n", r + 1, i); break;
+			default: text += fmt::format("\tRETURN r{}\n", r); break;
+		}
+	}
+	return text;
+}
+
+// A file in the temp directory for as long as this lives
+class TempFile {
+	public:
+		std::string path;
+
+		TempFile(std::string_view name, std::string_view text) {
+			path = fmt::format("/tmp/hir_bench_{}_{}", ::getpid(), name);
+
+			auto file = std::fopen(path.c_str(), "wb");
+			std::fwrite(text.data(), 1, text.size(), file);
+			std::fclose(file);
+		}
+
+		~TempFile() { std::remove(path.c_str()); }
+
+		TempFile(const TempFile&) = delete;
+		auto operator=(const TempFile&) -> TempFile& = delete;
+};
+
+}
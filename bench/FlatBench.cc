@@ -0,0 +1,102 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Bench.hh"
+
+#include <Compiler.hh>
+#include <node/FlatProgram.hh>
+
+using namespace hive::ir;
+
+/**
+ * The node tree against FlatProgram on a large generated module. Memory is
+ * what each form holds: for the tree the arena (nodes and the tokens they
+ * keep) plus the vectors inside nodes, for the flat form its tables. The
+ * traversal is the same pass written for each, it sums the output
+ * register of every two operand instruction and the kind of the rest.
+ *
+ *   FlatBench [instructions]
+ */
+static auto tree_bytes(Compiler& compiler, ProgNode* program) -> size {
+	size total = compiler.context().arena.stats().bytes_used + program->nodes.capacity() * sizeof(Node*);
+
+	For(program->nodes) {
+		if (it->kind == NodeKinds::DIRECTIVE_NODE) total += ((DirectiveNode*)it)->tokens.capacity() * sizeof(Token*);
+		if (it->kind != NodeKinds::LABEL_NODE) continue;
+
+		auto label = (LabelNode*)it;
+		total += label->instructions.capacity() * sizeof(Node*);
+
+		for (auto inst : label->instructions) {
+			if (inst->kind == NodeKinds::CALL_NODE) total += ((CallNode*)inst)->params.capacity() * sizeof(Node*);
+			if (inst->kind == NodeKinds::DATA_TYPE_NODE) total += ((DataTypeNode*)inst)->types.capacity() * sizeof(Node*);
+		}
+	}
+	return total;
+}
+
+static auto walk_tree(ProgNode* program) -> u64 {
+	u64 sum = 0;
+
+	For(program->nodes) {
+		if (it->kind != NodeKinds::LABEL_NODE) continue;
+
+		for (auto inst : ((LabelNode*)it)->instructions) {
+			if (inst->kind > NodeKinds::BI_NODE_START && inst->kind < NodeKinds::BI_NODE_END) {
+				sum += ((VirtualRegisterNode*)((BiNode*)inst)->out)->id;
+			} else {
+				sum += (u64)inst->kind;
+			}
+		}
+	}
+	return sum;
+}
+
+static auto walk_flat(const FlatProgram& flat) -> u64 {
+	u64 sum = 0;
+
+	For(flat.labels) {
+		for (auto& inst : flat.body(it)) {
+			if (inst.kind > NodeKinds::BI_NODE_START && inst.kind < NodeKinds::BI_NODE_END) {
+				sum += FlatProgram::reg_id(inst.ops[2]);
+			} else {
+				sum += (u64)inst.kind;
+			}
+		}
+	}
+	return sum;
+}
+
+int main(int argc, char** argv) {
+	size instructions = bench::arg(argc, argv, 1, 2'000'000);
+	bench::TempFile file("flat.hir", bench::module(instructions));
+
+	Compiler compiler(CompileOptions{1});
+	auto result = compiler.parse(file.path.c_str());
+	if (!result.ok()) {
+		fmt::print("{}\n", result.error->message);
+		return 1;
+	}
+
+	FlatProgram flat;
+	double build_time = bench::best_of(3, [&] { flat = FlatProgram(result.program); });
+
+	u64 tree_sum = 0;
+	u64 flat_sum = 0;
+	double tree_time = bench::best_of(5, [&] { tree_sum = walk_tree(result.program); });
+	double flat_time = bench::best_of(5, [&] { flat_sum = walk_flat(flat); });
+
+	size tree = tree_bytes(compiler, result.program);
+
+	fmt::print("{} instructions in {} labels\n", flat.instructions.size(), flat.labels.size());
+	fmt::print("  tree  {:8.1f} MB {:6.1f} bytes/instruction, walk {:7.2f} ms {:5.2f} ns/instruction\n",
+		tree / 1e6, (double)tree / instructions, tree_time * 1e3, tree_time * 1e9 / instructions);
+	fmt::print("  flat  {:8.1f} MB {:6.1f} bytes/instruction, walk {:7.2f} ms {:5.2f} ns/instruction, built in {:.2f} ms\n",
+		flat.bytes() / 1e6, (double)flat.bytes() / instructions, flat_time * 1e3, flat_time * 1e9 / instructions, build_time * 1e3);
+	fmt::print("  checksum {:x} {:x}\n", tree_sum, flat_sum);
+
+	return tree_sum == flat_sum ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Bench.hh"
+
+#include <token/TokenKind.hh>
+
+#include <vector>
+
+using namespace hive::ir;
+
+/**
+ * Keyword classification of every word a module lexes, kind_from_name's
+ * perfect hash (one hash, one compare) against the walk over every token
+ * name with a string compare each that it replaced.
+ *
+ *   KeywordBench [words]
+ */
+struct Named {
+	TokenKind kind;
+	std::string_view name;
+};
+
+static constexpr Named NAMES[] = {
+	#define Tok(kind, name) {TokenKind::kind, name},
+		TOKEN_TYPES_LIST
+	#undef Tok
+};
+
+static auto linear_kind(std::string_view name) -> TokenKind {
+	for (auto& it : NAMES) {
+		if (it.name == name) return it.kind;
+	}
+	return TokenKind::IDENT_LITERAL;
+}
+
+int main(int argc, char** argv) {
+	size count = bench::arg(argc, argv, 1, 10'000'000);
+
+	// keywords and identifiers in about the mix a generated module has
+	std::vector<std::string> pool;
+	for (std::string_view word : {"ADD", "SUBTRACT", "NOT", "MULTIPLY", "XOR", "DEREF", "STATIC", "CALL", "RETURN", "LABEL", "libc", "printf", "main", "label_1042", "i64", "FUNCTION"}) {
+		pool.emplace_back(word);
+	}
+
+	std::vector<std::string_view> words(count);
+	for (size i = 0; i < count; i++) words[i] = pool[(i * 7919) % pool.size()];
+
+	u64 hashed = 0;
+	u64 walked = 0;
+
+	double hash_time = bench::best_of(5, [&] {
+		hashed = 0;
+		for (auto word : words) hashed = hashed * 31 + (u8)kind_from_name(word);
+	});
+	double walk_time = bench::best_of(5, [&] {
+		walked = 0;
+		for (auto word : words) walked = walked * 31 + (u8)linear_kind(word);
+	});
+
+	fmt::print("keyword classification of {} words, {} token names\n", count, std::size(NAMES));
+	fmt::print("  perfect hash  {:8.2f} ns/word  checksum {:x}\n", hash_time * 1e9 / count, hashed);
+	fmt::print("  linear walk   {:8.2f} ns/word  checksum {:x}\n", walk_time * 1e9 / count, walked);
+	fmt::print("  speedup       {:8.2f}x\n", walk_time / hash_time);
+
+	return hashed == walked ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Bench.hh"
+
+#include <parse/Lex.hh>
+#include <parse/LexTable.hh>
+#include <parse/Scan.hh>
+#include <token/TokenBuffer.hh>
+
+#include <vector>
+
+using namespace hive::ir;
+
+/**
+ * Tokens per second of the table driven lexer on a generated module, and
+ * the part the tables replaced on its own: telling what kind of word
+ * (identifier, register or number) starts at each word of the module. The
+ * DFA is stepped as Lex::concat_word steps it, the switch is the per
+ * character code the lexer had before.
+ *
+ *   LexBench [instructions]
+ */
+struct Word {
+	TokenKind kind;
+	u32 length;
+};
+
+static auto dfa_word(const char* start, const ScanKernels& scan) -> Word {
+	auto ptr   = start;
+	auto state = LexState::START;
+
+	for (;;) {
+		auto next = lex_table::transitions[(size)state][(u8)*ptr];
+		if (next >= LexState::DONE) break;
+
+		state = next;
+		ptr++;
+
+		if (state == LexState::IDENT) {
+			ptr = scan.ident_end(ptr);
+			break;
+		}
+	}
+	return Word{lex_table::accept_kind(state), (u32)(ptr - start)};
+}
+
+static auto is_digit(char c) -> bool { return c >= '0' && c <= '9'; }
+
+static auto switch_word(const char* start, const ScanKernels& scan) -> Word {
+	auto ptr = start;
+
+	switch (*ptr) {
+		case 'r':
+		case 'd': {
+			auto kind = *ptr == 'r' ? TokenKind::REGISTER : TokenKind::DATA;
+			ptr++;
+			while (is_digit(*ptr)) ptr++;
+			return Word{kind, (u32)(ptr - start)};
+		}
+		default: break;
+	}
+
+	if (!is_digit(*ptr)) {
+		ptr = scan.ident_end(ptr);
+		return Word{TokenKind::IDENT_LITERAL, (u32)(ptr - start)};
+	}
+
+	auto kind = TokenKind::DIGIT_LITERAL;
+
+	if (ptr[0] == '0' && ptr[1] == 'x') {
+		kind = TokenKind::HEX_LITERAL;
+		ptr += 2;
+		while (is_digit(*ptr) || (*ptr >= 'a' && *ptr <= 'f') || (*ptr >= 'A' && *ptr <= 'F')) ptr++;
+	} else if (ptr[0] == '0' && ptr[1] == 'b') {
+		kind = TokenKind::BINARY_LITERAL;
+		ptr += 2;
+		while (*ptr == '0' || *ptr == '1') ptr++;
+	} else if (ptr[0] == '0' && ptr[1] == 'o') {
+		kind = TokenKind::OCTAL_LITERAL;
+		ptr += 2;
+		while (*ptr >= '0' && *ptr <= '7') ptr++;
+	} else {
+		while (is_digit(*ptr) || *ptr == '.') {
+			if (*ptr == '.') kind = TokenKind::FLOAT_LITERAL;
+			ptr++;
+		}
+	}
+	return Word{kind, (u32)(ptr - start)};
+}
+
+int main(int argc, char** argv) {
+	size instructions = bench::arg(argc, argv, 1, 2'000'000);
+	auto text = bench::module(instructions);
+	bench::TempFile file("lex.hir", text);
+
+	size tokens = 0;
+	double lex_time = bench::best_of(3, [&] {
+		Context ctx;
+		Lex lex(file.path.c_str(), LexMode::TRIVIA_FREE, &ctx);
+		TokenBuffer buffer;
+
+		tokens = 0;
+		for (bool done = false; !done;) {
+			size first = buffer.count;
+			lex.next(buffer);
+			for (size n = first; n < buffer.count; n++) done = done || buffer.kind(n) == TokenKind::_EOF;
+			tokens += buffer.count - first;
+		}
+	});
+
+	// every word outside of string literals, the way the lexer reaches them
+	text.append(64, '\0');
+	std::vector<const char*> words;
+	bool in_string = false;
+
+	for (size i = 0; i + 64 < text.size(); i++) {
+		char c = text[i];
+		if (c == '"') in_string = !in_string;
+		if (in_string || !lex_table::is_word(lex_table::char_classes[(u8)c])) continue;
+
+		words.push_back(text.data() + i);
+		while (lex_table::is_word(lex_table::char_classes[(u8)text[i + 1]])) i++;
+	}
+
+	auto& scan = scan_kernels();
+	u64 dfa_sum = 0;
+	u64 switch_sum = 0;
+
+	double dfa_time = bench::best_of(5, [&] {
+		dfa_sum = 0;
+		for (auto word : words) {
+			auto found = dfa_word(word, scan);
+			dfa_sum = dfa_sum * 31 + (u8)found.kind + found.length;
+		}
+	});
+	double switch_time = bench::best_of(5, [&] {
+		switch_sum = 0;
+		for (auto word : words) {
+			auto found = switch_word(word, scan);
+			switch_sum = switch_sum * 31 + (u8)found.kind + found.length;
+		}
+	});
+
+	fmt::print("lexer: {} tokens, {:.1f} MB, {:.1f} Mtok/s, {:.2f} GB/s\n", tokens, (text.size() - 64) / 1e6, tokens / lex_time / 1e6, (text.size() - 64) / lex_time / 1e9);
+	fmt::print("word kinds of {} words\n", words.size());
+	fmt::print("  dfa tables  {:6.2f} ns/word  checksum {:x}\n", dfa_time * 1e9 / words.size(), dfa_sum);
+	fmt::print("  switch      {:6.2f} ns/word  checksum {:x}\n", switch_time * 1e9 / words.size(), switch_sum);
+
+	return dfa_sum == switch_sum ? 0 : 1;
+}
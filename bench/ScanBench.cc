@@ -0,0 +1,113 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Bench.hh"
+
+#include <parse/Scan.hh>
+
+#include <vector>
+
+using namespace hive::ir;
+
+/**
+ * The scan kernels at every level this cpu has, in GB/s. Run kernels go
+ * over buffers of runs of one length each, the way the lexer calls them,
+ * so short runs show the fixed cost and long ones the per byte cost.
+ * line_starts goes over a generated module.
+ *
+ *   ScanBench [megabytes]
+ */
+using RunKernel = auto (*)(const char*) -> const char*;
+
+// bytes runs of run_byte each length long and ended by end_byte, then the zero padding the kernels rely on
+static auto runs(size bytes, size length, char run_byte, char end_byte) -> std::string {
+	std::string text;
+	text.reserve(bytes + 64);
+
+	while (text.size() + length + 1 <= bytes) {
+		text.append(length, run_byte);
+		text.push_back(end_byte);
+	}
+	text.append(64, '\0');
+	return text;
+}
+
+static auto run_rate(RunKernel kernel, const std::string& text, u64& checksum) -> double {
+	auto begin = text.data();
+	auto end   = begin + text.size() - 64;
+
+	double took = bench::best_of(5, [&] {
+		checksum = 0;
+		for (auto ptr = begin; ptr < end; ptr++) {
+			ptr = kernel(ptr);
+			checksum += ptr - begin;
+		}
+	});
+	return (end - begin) / took / 1e9;
+}
+
+int main(int argc, char** argv) {
+	size bytes = bench::arg(argc, argv, 1, 64) * 1024 * 1024;
+
+	std::vector<const ScanKernels*> levels;
+	for (auto level : {ScanLevel::SCALAR, ScanLevel::SSE2, ScanLevel::AVX2}) {
+		auto& kernels = scan_kernels(level);
+		if (kernels.level == level) levels.push_back(&kernels);
+	}
+
+	struct Run {
+		const char* name;
+		char run_byte;
+		char end_byte;
+		RunKernel ScanKernels::* kernel;
+	};
+
+	constexpr Run RUNS[] = {
+		{"ident_end", 'a', ' ', &ScanKernels::ident_end},
+		{"quote_end", 'a', '"', &ScanKernels::quote_end},
+		{"blank_end", ' ', 'a', &ScanKernels::blank_end},
+	};
+
+	fmt::print("scan kernels over {} MB, GB/s\n", bytes / (1024 * 1024));
+	fmt::print("  {:<24}", "");
+	for (auto kernels : levels) fmt::print("{:>10}", kernels->name);
+	fmt::print("\n");
+
+	for (auto& run : RUNS) {
+		for (size length : {4, 16, 64, 1024}) {
+			auto text = runs(bytes, length, run.run_byte, run.end_byte);
+			u64 first = 0;
+
+			fmt::print("  {:<12} runs of {:<4}", run.name, length);
+			for (auto kernels : levels) {
+				u64 checksum = 0;
+				fmt::print("{:10.2f}", run_rate(kernels->*run.kernel, text, checksum));
+
+				if (kernels == levels[0]) first = checksum;
+				if (checksum != first) fmt::print(" (differs from {})", levels[0]->name);
+			}
+			fmt::print("\n");
+		}
+	}
+
+	auto text = bench::module(bytes / 24);
+	text.append(64, '\0');
+	size length = text.size() - 64;
+
+	fmt::print("  {:<24}", "line_starts module");
+	for (auto kernels : levels) {
+		std::vector<u32> lines;
+		lines.reserve(length / 8);
+
+		double took = bench::best_of(5, [&] {
+			lines.clear();
+			kernels->line_starts(text.data(), length, lines);
+		});
+		fmt::print("{:10.2f}", length / took / 1e9);
+	}
+	fmt::print("\n");
+	return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Bench.hh"
+
+#include <server/Server.hh>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+#include <thread>
+#include <vector>
+
+using namespace hive::ir;
+
+/**
+ * The same small file compiled 10k times the way a build would, a hir
+ * process per file against requests to a compile server. The server runs
+ * in this process, so the client rows are the thin `hir --connect` process
+ * a build would launch and the bare request without any process start.
+ * Every compile emits text, the checksum adds up the exit codes.
+ *
+ *   ServerBench [compiles] [hir executable]
+ */
+extern char** environ;
+
+// Runs args to completion with its output thrown away, the exit code
+static auto launch(std::vector<const char*> args) -> int {
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+
+	args.push_back(nullptr);
+
+	pid_t pid;
+	int status = -1;
+
+	if (posix_spawn(&pid, args[0], &actions, nullptr, (char* const*)args.data(), environ) == 0) {
+		::waitpid(pid, &status, 0);
+	}
+
+	posix_spawn_file_actions_destroy(&actions);
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+auto main(int argc, char** argv) -> int {
+	size compiles = bench::arg(argc, argv, 1, 10'000);
+	const char* hir = argc > 2 ? argv[2] : HIR_EXECUTABLE;
+
+	std::string text = bench::module(40);
+	bench::TempFile source("server.hir", text);
+	bench::TempFile output("server.txt", "");
+	std::string socket = fmt::format("/tmp/hir_bench_{}.sock", ::getpid());
+
+	Server server(socket, 1);
+	std::thread serving([&] { server.run(); });
+
+	std::vector<const char*> args = {source.path.c_str(), "--emit-text", output.path.c_str()};
+	std::string out;
+
+	// run() binds in the background, wait for the first request to go through
+	while (forward(socket.c_str(), args, out) != 0) {
+		std::this_thread::yield();
+	}
+
+	fmt::println("{} compiles of a {} byte file", compiles, text.size());
+
+	u64 process_sum = 0;
+	double process = bench::best_of(1, [&] {
+		for (size i = 0; i < compiles; i++) {
+			process_sum += launch({hir, source.path.c_str(), "--emit-text", output.path.c_str()});
+		}
+	});
+
+	u64 client_sum = 0;
+	double client = bench::best_of(1, [&] {
+		for (size i = 0; i < compiles; i++) {
+			client_sum += launch({hir, "--connect", socket.c_str(), source.path.c_str(), "--emit-text", output.path.c_str()});
+		}
+	});
+
+	u64 request_sum = 0;
+	double request = bench::best_of(1, [&] {
+		for (size i = 0; i < compiles; i++) {
+			request_sum += forward(socket.c_str(), args, out);
+		}
+	});
+
+	server.stop();
+	serving.join();
+
+	fmt::println("hir process     {:8.3f} s  {:8.1f} us/compile  checksum {}", process, process / compiles * 1e6, process_sum);
+	fmt::println("hir --connect   {:8.3f} s  {:8.1f} us/compile  checksum {}", client, client / compiles * 1e6, client_sum);
+	fmt::println("server request  {:8.3f} s  {:8.1f} us/compile  checksum {}", request, request / compiles * 1e6, request_sum);
+	return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Bench.hh"
+
+#include <parse/Lex.hh>
+#include <token/TokenBuffer.hh>
+
+#include <fstream>
+#include <memory>
+#include <vector>
+
+using namespace hive::ir;
+
+/**
+ * Memory per token on a generated file of about 10M tokens. The lexer
+ * writes into a TokenBuffer ring, a fixed size whatever the file. Against
+ * it the layout the lexer had before, one heap object per token holding
+ * its text, kind and a position with the file path, kept in a vector of
+ * pointers for the parser. Growth is measured as resident memory.
+ *
+ *   TokenMemoryBench [tokens]
+ */
+struct HeapPos {
+	std::string path;
+	size offset_start;
+	size line;
+	size column;
+	size offset_end;
+	size len;
+};
+
+struct HeapToken {
+	std::string name;
+	TokenKind kind;
+	HeapPos pos;
+};
+
+static auto resident_bytes() -> size {
+	size pages = 0;
+	size resident = 0;
+	std::ifstream("/proc/self/statm") >> pages >> resident;
+	return resident * ::sysconf(_SC_PAGESIZE);
+}
+
+// Lexes the whole file, calling each for every slot the lexer appends. The source is unmapped again on return
+template<typename Each>
+static auto lex_all(const std::string& path, Each&& each) -> size {
+	Context ctx;
+	Lex lex(path.c_str(), LexMode::TRIVIA_FREE, &ctx);
+	TokenBuffer tokens;
+	size count = 0;
+
+	for (;;) {
+		size first = tokens.count;
+		lex.next(tokens);
+
+		bool done = false;
+		for (size n = first; n < tokens.count; n++) {
+			each(lex, tokens, n);
+			done = done || tokens.kind(n) == TokenKind::_EOF;
+			count++;
+		}
+		if (done) return count;
+	}
+}
+
+int main(int argc, char** argv) {
+	size wanted = bench::arg(argc, argv, 1, 10'000'000);
+	bench::TempFile file("tokens.hir", bench::module(wanted / 6));
+
+	u64 checksum = 0;
+
+	// the first pass warms the page cache and the allocator
+	size count = lex_all(file.path, [&](Lex&, TokenBuffer& tokens, size n) { checksum += tokens.length(n); });
+
+	size before = resident_bytes();
+	double ring_time = bench::best_of(3, [&] {
+		lex_all(file.path, [&](Lex&, TokenBuffer& tokens, size n) { checksum += tokens.length(n); });
+	});
+	size ring_growth = resident_bytes() - before;
+
+	before = resident_bytes();
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<std::unique_ptr<HeapToken>> heap;
+	heap.reserve(count);
+
+	lex_all(file.path, [&](Lex& lex, TokenBuffer& tokens, size n) {
+		auto offset = tokens.offset(n);
+		auto length = tokens.length(n);
+		heap.push_back(std::make_unique<HeapToken>(HeapToken{std::string(lex.name(tokens, n)), tokens.kind(n), HeapPos{file.path, offset, 0, 0, offset + length, length}}));
+	});
+	double heap_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	size heap_growth = resident_bytes() - before;
+
+	constexpr size SLOT = sizeof(TokenBuffer::kinds[0]) + sizeof(TokenBuffer::trivia[0]) + sizeof(TokenBuffer::widths[0])
+		+ sizeof(TokenBuffer::offsets[0]) + sizeof(TokenBuffer::lengths[0]) + sizeof(TokenBuffer::values[0]);
+
+	fmt::print("{} tokens in {:.1f} MB of source\n", count, std::ifstream(file.path, std::ios::ate).tellg() / 1e6);
+	fmt::print("  TokenBuffer ring  {:>8} bytes for any file, {} bytes a slot, {:.1f} bytes/token resident growth, {:.1f} Mtok/s\n",
+		sizeof(TokenBuffer), SLOT, (double)ring_growth / count, count / ring_time / 1e6);
+	fmt::print("  heap token each   {:>8.1f} MB, {:.1f} bytes/token resident growth, {:.1f} Mtok/s\n",
+		heap_growth / 1e6, (double)heap_growth / count, count / heap_time / 1e6);
+	fmt::print("  checksum {:x}\n", checksum);
+	return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Bench.hh"
+
+#include <Compiler.hh>
+#include <node/Visitor.hh>
+
+#include <vector>
+
+using namespace hive::ir;
+
+/**
+ * Per node dispatch over a module of 10M instructions, NodeVisitor's
+ * switch on Node::kind against the virtual way to get at a typed node,
+ * a dynamic_cast per candidate class. The handlers are the same for both
+ * and do almost nothing, so the time is the dispatch.
+ *
+ *   VisitBench [instructions]
+ */
+static auto id(Node* reg) -> u64 { return ((VirtualRegisterNode*)reg)->id; }
+
+class Sum : public NodeVisitor<Sum, u64> {
+	public:
+		using NodeVisitor::visit;
+
+		auto visit(BiNode* node) -> u64 { return id(node->out); }
+		auto visit(NotNode* node) -> u64 { return id(node->out); }
+		auto visit(DerefNode* node) -> u64 { return id(node->out); }
+		auto visit(ReturnNode* node) -> u64 { return id(node->reg); }
+		auto visit(CallNode* node) -> u64 { return node->params.size(); }
+		auto visit(Node* node) -> u64 { return (u64)node->kind; }
+};
+
+static auto cast_sum(Node* node) -> u64 {
+	if (auto bi = dynamic_cast<BiNode*>(node)) return id(bi->out);
+	if (auto inv = dynamic_cast<NotNode*>(node)) return id(inv->out);
+	if (auto deref = dynamic_cast<DerefNode*>(node)) return id(deref->out);
+	if (auto ret = dynamic_cast<ReturnNode*>(node)) return id(ret->reg);
+	if (auto call = dynamic_cast<CallNode*>(node)) return call->params.size();
+	return (u64)node->kind;
+}
+
+int main(int argc, char** argv) {
+	size instructions = bench::arg(argc, argv, 1, 10'000'000);
+	bench::TempFile file("visit.hir", bench::module(instructions));
+
+	Compiler compiler;
+	auto result = compiler.parse(file.path.c_str());
+	if (!result.ok()) {
+		fmt::print("{}\n", result.error->message);
+		return 1;
+	}
+
+	std::vector<Node*> nodes;
+	nodes.reserve(instructions);
+	For(result.program->nodes) {
+		if (it->kind == NodeKinds::LABEL_NODE) {
+			for (auto inst : ((LabelNode*)it)->instructions) nodes.push_back(inst);
+		}
+	}
+
+	u64 visited = 0;
+	u64 casted  = 0;
+
+	double visit_time = bench::best_of(5, [&] {
+		Sum sum;
+		visited = 0;
+		for (auto node : nodes) visited += sum.dispatch(node);
+	});
+	double cast_time = bench::best_of(5, [&] {
+		casted = 0;
+		for (auto node : nodes) casted += cast_sum(node);
+	});
+
+	fmt::print("dispatch over {} instructions\n", nodes.size());
+	fmt::print("  NodeVisitor   {:6.2f} ns/node  checksum {:x}\n", visit_time * 1e9 / nodes.size(), visited);
+	fmt::print("  dynamic_cast  {:6.2f} ns/node  checksum {:x}\n", cast_time * 1e9 / nodes.size(), casted);
+
+	return visited == casted ? 0 : 1;
+}
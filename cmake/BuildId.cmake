@@ -0,0 +1,31 @@
+# Writes the build id of hir to OUTPUT as HIR_BUILD_ID, see include/BuildId.hh
+#
+#   cmake -DSOURCE_DIR=<dir> -DVERSION=<version> -DOUTPUT=<file> -P BuildId.cmake
+#
+# The id is the project version and a hash of every source hir is built
+# from, so a new commit, a local edit or a tarball each get their own. It
+# runs on every build and only rewrites OUTPUT when the id changed, so an
+# unchanged tree rebuilds nothing.
+
+file(GLOB_RECURSE sources ${SOURCE_DIR}/src/* ${SOURCE_DIR}/include/*)
+list(APPEND sources ${SOURCE_DIR}/CMakeLists.txt)
+list(SORT sources)
+
+set(listing "")
+foreach(source ${sources})
+	file(SHA1 ${source} hash)
+	file(RELATIVE_PATH name ${SOURCE_DIR} ${source})
+	string(APPEND listing "${name} ${hash}\n")
+endforeach()
+
+string(SHA1 tree "${listing}")
+set(content "#define HIR_BUILD_ID \"${VERSION}+${tree}\"\n")
+
+set(previous "")
+if(EXISTS ${OUTPUT})
+	file(READ ${OUTPUT} previous)
+endif()
+
+if(NOT previous STREQUAL content)
+	file(WRITE ${OUTPUT} "${content}")
+endif()
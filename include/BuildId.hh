@@ -0,0 +1,16 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <string_view>
+
+namespace hive::ir {
+
+// Version of this build and a hash of the sources it was built from. Another build may print or encode the same source differently, so anything kept between runs is keyed on this
+auto build_id() -> std::string_view;
+
+}
@@ -0,0 +1,45 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Compiler.hh>
+
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace hive::ir {
+
+// Where a command line runs, the server fills this in for its clients
+struct CliEnv {
+	std::string_view cwd; // relative paths are taken from here, empty is the process cwd. Set means a client of the server, which can not read stdin
+	size threads = 0;     // -j when the command line has none, 0 is one per hardware thread
+};
+
+constexpr const char* CLI_USAGE =
+	"usage: hir <input>... [@<response file>] [-j <threads>] [--emit-binary <output>] [--emit-text <output>] [--cache <dir>] [--cache-size <bytes>] [--incremental <state>]\n"
+	"       hir --serve <socket> [-j <workers>]\n"
+	"       hir --connect <socket> <input> [options]";
+
+/**
+ * Runs one hir command line, args are everything after the program name
+ * with @file arguments replaced by the words in that file. What the CLI
+ * prints goes into out instead of stdout and the exit code is returned, so
+ * main and the compile server share this.
+ *
+ * A single input is compiled on compiler with -j threads for its parse.
+ * Several inputs are compiled one per job on a pool of -j threads and the
+ * --emit-* options name output directories.
+ *
+ * With --cache every output is looked up in and stored to a Cache, an
+ * input whose outputs are all cached is not parsed at all. With
+ * --incremental and only text outputs just the LABEL groups that changed
+ * since the last run are parsed, see Compiler::emit_incremental.
+ */
+auto run_cli(Compiler& compiler, std::span<const char* const> args, const CliEnv& env, std::string& out) -> int;
+
+}
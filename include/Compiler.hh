@@ -0,0 +1,78 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Context.hh>
+#include <node/Node.hh>
+#include <err/Diagnostic.hh>
+
+#include <optional>
+#include <string>
+
+namespace hive::ir {
+
+enum class EmitKind : u8 {
+	TEXT,   // IR text as Printer writes it
+	BINARY, // see binary/Binary.hh
+};
+
+struct CompileOptions {
+	size threads = 0; // for text input, 0 is one per hardware thread and 1 parses on the calling thread
+};
+
+struct CompileResult {
+	ProgNode* program = nullptr; // owned by the Compiler that made it
+	std::optional<Diagnostic> error;
+
+	auto ok() const -> bool { return !error; }
+};
+
+/**
+ * Entry point for using hir as a library. Each Compiler owns the Context of
+ * one compilation and keeps no state anywhere else, so any number of them
+ * can run at once on different threads. Nothing in here prints or exits,
+ * failures come back as a Diagnostic.
+ *
+ *   Compiler compiler;
+ *   auto result = compiler.parse("main.hir");
+ *   if (!result.ok()) report(result.error->message);
+ *
+ * Trees from parse() live in the Compiler's arena and are gone with it.
+ */
+class Compiler {
+	public:
+		explicit Compiler(CompileOptions options = {});
+
+		Compiler(const Compiler&) = delete;
+		auto operator=(const Compiler&) -> Compiler& = delete;
+
+		// Text or binary IR, told apart by the magic. "-" reads text from stdin
+		auto parse(const char* target) -> CompileResult;
+
+		// Renders program into out
+		auto emit(ProgNode* program, EmitKind kind, std::string& out) -> std::optional<Diagnostic>;
+		auto emit(ProgNode* program, EmitKind kind, const char* target) -> std::optional<Diagnostic>;
+
+		/**
+		 * Text output of a text input without parsing the LABEL groups that
+		 * are unchanged since the last call with the same state file, their
+		 * text comes out of the state instead. The state is rewritten on
+		 * success and left alone on an error.
+		 */
+		auto emit_incremental(const char* target, const char* state, std::string& out) -> std::optional<Diagnostic>;
+
+		// Drops everything parsed so far so the Compiler can take the next input with warm memory
+		auto reset(CompileOptions options) -> void;
+
+		auto context() -> Context& { return ctx; }
+
+	private:
+		CompileOptions options;
+		Context ctx;
+};
+
+}
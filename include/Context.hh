@@ -0,0 +1,38 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <parse/SourceMap.hh>
+#include <node/RegisterTable.hh>
+#include <util/Arena.hh>
+#include <util/Interner.hh>
+
+namespace hive::ir {
+
+/**
+ * State owned by a single compilation. Tokens and nodes live in the arena,
+ * identifiers in the interner, registers in the register table and file
+ * paths in the source map, so nothing produced by Lex or Parse outlives the
+ * context.
+ */
+class Context {
+	public:
+		Arena arena;
+		Interner interner;
+		SourceMap sources;
+		RegisterTable registers;
+
+		// Back to an empty compilation, keeping the memory the last one warmed up
+		auto reset() -> void {
+			arena.reset();
+			registers.clear();
+			interner.clear();
+			sources.clear();
+		}
+};
+
+}
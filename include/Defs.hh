@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 
 #include <fmt/core.h>
 #include <fmt/color.h>
@@ -25,15 +26,19 @@ using size = size_t;
 #define Log(msg) fmt::print("[LOG] {}\n",   msg);
 #define LogRaw(msg) fmt::print("[LOG] {} ", msg);
 #define Warn(msg) fmt::print("[WARN] {}\n", msg);
-#define Panic(msg) fmt::print("[PANIC] {}:{}\n{}\n",__FILE__, __LINE__, fmt::format(fg(fmt::color::red), msg)); std::exit(-1);
+namespace hive::ir {
+// Throws a CompileError with INTERNAL_ERROR, see err/Diagnostic.hh
+[[noreturn]] auto panic(const char* file, int line, std::string msg) -> void;
+}
+
+#define Panic(msg) hive::ir::panic(__FILE__, __LINE__, msg);
 
 #define For(iterable) for (auto& it : iterable)
 
 #ifdef DEBUG
 #define Assert(expression, msg)                                                                         \
 	if ((expression)) {                                                                                   \
-		fmt::print("assert in file {}:{}\n{}\n",__FILE__, __LINE__,fmt::format(fg(fmt::color::red), msg));  \
-		std::exit(-1);                                                                                      \
+		hive::ir::panic(__FILE__, __LINE__, fmt::format("assert: {}", msg));                                \
 	}
 
 #define DebugInfo(msg) fmt::print("[DEBUG] {}\n", msg);
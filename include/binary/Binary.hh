@@ -0,0 +1,59 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Defs.hh>
+
+namespace hive::ir {
+
+/**
+ * Binary IR layout, all integers little endian.
+ *
+ *   BinaryHeader
+ *   strings      u32 offsets[string_count + 1] followed by the string bytes
+ *   labels       BinaryLabel[label_count], in source order
+ *   directives   directive_count encoded directives
+ *   bodies       every label's name as a literal, then its encoded
+ *                instructions
+ *
+ * Inside directives and bodies integers are LEB128 varints:
+ *
+ *   register     varint (id << 1 | is_data_register)
+ *   literal      u8 NodeKinds, varint string id
+ *   type         u8 NodeKinds
+ *   directive    varint labels_before, literal name, varint token_count,
+ *                token_count * (u8 TokenKind, varint string id)
+ *   instruction  u8 NodeKinds followed by its operands in the order they
+ *                are written in text, CALL and data types prefix their
+ *                lists with a varint count
+ */
+
+constexpr char BINARY_MAGIC[4]  = {'H', 'I', 'R', 'B'};
+constexpr u16  BINARY_VERSION   = 2;
+
+struct BinaryHeader {
+	char magic[4];
+	u16  version;
+	u16  flags;
+	u32  string_count;
+	u32  strings_offset;
+	u32  label_count;
+	u32  labels_offset;
+	u32  directive_count;
+	u32  directives_offset;
+};
+
+struct BinaryLabel {
+	u32 name;   // string id, the same one as the literal at offset
+	u32 offset; // start of the label body in the file
+	u32 count;  // number of instructions
+};
+
+static_assert(sizeof(BinaryHeader) == 32);
+static_assert(sizeof(BinaryLabel) == 12);
+
+}
@@ -0,0 +1,70 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Context.hh>
+#include <err/Diagnostic.hh>
+#include <binary/Binary.hh>
+#include <node/Node.hh>
+#include <parse/SourceBuffer.hh>
+
+#include <string_view>
+#include <vector>
+
+namespace hive::ir {
+
+/**
+ * Reads the binary IR written by BinaryWriter straight out of the mapped
+ * file. Nothing is tokenized, and a label's nodes are only built the first
+ * time that label is asked for.
+ */
+class BinaryReader {
+	using Kind = NodeKinds;
+
+	public:
+		BinaryReader(const char* target, Context* ctx);
+
+		static auto is_binary(const char* target) -> bool;
+
+		auto label_count() -> size;
+		auto label_name(size idx) -> std::string_view;
+		auto label(size idx) -> LabelNode*;
+
+		auto program() -> ProgNode*;
+
+	private:
+		Context* ctx;
+		FileId file;
+		SourceBuffer* source;
+		BinaryHeader header;
+		std::vector<LabelNode*> labels;
+
+		const u8* cursor = nullptr;
+		const u8* end    = nullptr;
+
+	private:
+		auto string(u32 id) -> std::string_view;
+		auto label_entry(size idx) -> BinaryLabel;
+
+		auto seek(size offset) -> void;
+		auto byte() -> u8;
+		auto varint() -> u64;
+		auto items(u64 count) -> size;
+
+		auto token(TokenKind kind, std::string_view name) -> Token*;
+		auto token(TokenKind kind) -> Token*;
+
+		auto directive(size& labels_before) -> Node*;
+		auto instruction() -> Node*;
+		auto reg() -> Node*;
+		auto literal() -> Node*;
+		auto type() -> Node*;
+
+		[[noreturn]] auto binary_error(std::string msg) -> void;
+};
+
+}
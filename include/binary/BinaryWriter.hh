@@ -0,0 +1,46 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <binary/Binary.hh>
+#include <node/Node.hh>
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace hive::ir {
+
+class BinaryWriter {
+	using Kind = NodeKinds;
+
+	public:
+		explicit BinaryWriter(ProgNode* program);
+
+		auto encode() -> std::string;
+		auto write(std::string target) -> void;
+
+	private:
+		ProgNode* program;
+		std::string body;
+		std::vector<std::string_view> strings;
+		std::unordered_map<std::string_view, u32> string_ids;
+
+	private:
+		auto string(std::string_view str) -> u32;
+
+		auto byte(u8 value) -> void;
+		auto varint(u64 value) -> void;
+
+		auto directive(DirectiveNode* directive, size labels_before) -> void;
+		auto instruction(Node* node) -> void;
+		auto reg(Node* node) -> void;
+		auto literal(Node* node) -> u32; // the string id of its text
+};
+
+}
@@ -0,0 +1,73 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Compiler.hh>
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace hive::ir {
+
+using CacheKey = u64;
+
+/**
+ * On disk cache of emitted outputs, one file per entry named after the
+ * xxh64 of everything the output depends on: the source bytes, the emit
+ * kind and the hir build, see BuildId.hh. Directives like
+ * #target are part of the source so they are covered, -j is not since it
+ * never changes the output.
+ *
+ * Several hir processes can share a directory. Entries are written to a
+ * temporary file and renamed into place so a reader sees a whole entry or
+ * none, a hit bumps the entry's mtime, and trim() evicts the least recently
+ * used entries past max_bytes while holding an flock on the directory's
+ * lock file so only one process evicts at a time. Everything is best
+ * effort, a cache that can not be read or written is a miss.
+ */
+class Cache {
+	public:
+		static constexpr size DEFAULT_MAX_BYTES = 1024 * 1024 * 1024;
+
+		Cache(std::string dir, size max_bytes = DEFAULT_MAX_BYTES);
+
+		// Creates the directory if it is missing
+		auto open() -> std::optional<Diagnostic>;
+
+		static auto key(std::string_view source, EmitKind kind) -> CacheKey;
+
+		// Copies the entry into target with one mmap and write, false on a miss
+		auto fetch(CacheKey key, const char* target) -> bool;
+		auto store(CacheKey key, std::string_view bytes) -> void;
+
+		/**
+		 * Adds what store() wrote to the total kept in the lock file and only
+		 * lists the directory when that total is past max_bytes or there is
+		 * no total yet, the listing then evicts and sets the real total. Does
+		 * nothing when this Cache stored nothing.
+		 */
+		auto trim() -> void;
+
+		auto hits() const -> size { return hit_count; }
+		auto misses() const -> size { return miss_count; }
+
+	private:
+		std::string dir;
+		size max_bytes;
+		std::atomic<size> hit_count  = 0;
+		std::atomic<size> miss_count = 0;
+		std::atomic<size> temp_count = 0;
+		std::atomic<size> stored_bytes = 0; // since the last trim()
+
+	private:
+		auto entry_path(CacheKey key) const -> std::string;
+		auto evict(int lock) -> void;
+};
+
+}
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <node/Node.hh>
+#include <node/FlatProgram.hh>
 
 #include <string>
 
@@ -28,6 +29,8 @@ class ICodegen {
 
 	protected:
 		ProgNode* program;
+		FlatProgram flat; // the same program as one instruction array, for walking bodies
+		const FlatInst* current = nullptr; // what the hook emit() called is for
 		std::string instruction_bufffer;
 
 	protected:
@@ -60,6 +63,9 @@ class ICodegen {
 		virtual auto mul() -> void = 0;
 		virtual auto div() -> void = 0;
 
+		// Calls the hook INSTRUCTION_LIST gives inst, instruction() for anything without one
+		auto emit(const FlatInst& inst) -> void;
+
 		auto write(std::string target) -> void;
 
 
@@ -0,0 +1,39 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <err/ErrorCodes.hh>
+
+#include <exception>
+#include <string>
+
+namespace hive::ir {
+
+// What went wrong, message is the full line the CLI prints e.g. "Parse Error: ..."
+struct Diagnostic {
+	ErrorCode code;
+	std::string message;
+};
+
+/**
+ * Thrown by the lexer, parser, binary reader/writer and Panic in place of
+ * exiting, so a failed compilation unwinds back to whoever started it and
+ * the process keeps going. Compiler catches it and hands back the
+ * Diagnostic, it never leaves the library.
+ */
+class CompileError : public std::exception {
+	public:
+		Diagnostic diagnostic;
+
+		explicit CompileError(Diagnostic diagnostic) : diagnostic(std::move(diagnostic)) {}
+
+		auto what() const noexcept -> const char* override { return diagnostic.message.c_str(); }
+};
+
+[[noreturn]] auto compile_error(ErrorCode code, std::string message) -> void;
+
+}
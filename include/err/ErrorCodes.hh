@@ -4,13 +4,19 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#pragma once
+
 #include <Defs.hh>
 
 namespace hive::ir {
 
 enum ErrorCode  : i8 {
+	IO_ERROR        = -3,
 	PARSE_ERROR     = -20,
 	NOT_IMPLEMENTED = -21,
+	LEX_ERROR       = -22,
+	BINARY_ERROR    = -23,
+	INTERNAL_ERROR  = -24, // a Panic or Assert
 };
 
 }
@@ -0,0 +1,99 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <node/Node.hh>
+#include <node/Instruction.hh>
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace hive::ir {
+
+/**
+ * An operand slot of a FlatInst, what it holds depends on the opcode
+ *
+ *   register   id << 1 | is_data_register, same as the binary format, ids
+ *              past MAX_REGISTER are a compile error
+ *   literal    index into FlatProgram::literals
+ *   list       index into FlatProgram::extra where a count is followed by
+ *              that many registers (CALL) or type NodeKinds (data types)
+ */
+using FlatOperand = u32;
+
+struct FlatInst {
+	NodeKinds kind;
+	u8 count;  // operand slots in use
+	u16 pad = 0;
+	FlatOperand ops[3];
+};
+
+struct FlatLiteral {
+	NodeKinds kind;
+	std::string_view text; // without the quotes for strings
+	TokenValue value;      // for numbers, as the lexer decoded it
+};
+
+struct FlatLabel {
+	std::string_view name;
+	u32 first; // index of the first instruction
+	u32 count;
+};
+
+struct FlatDirective {
+	u32 labels_before; // where it sat between the labels
+	u32 name;          // literal
+	u32 first_word;    // index into FlatProgram::words
+	u32 word_count;
+};
+
+static_assert(sizeof(FlatInst) == 16);
+
+/**
+ * Flat form of a ProgNode for passes that walk every instruction. All
+ * instructions live in one array of 16 byte records with the registers
+ * inline, labels are ranges over it and the few variable length parts sit
+ * in side tables, so a pass never chases a pointer per node.
+ *
+ * Views point into the token text of the tree it was built from so the
+ * source has to outlive it.
+ */
+class FlatProgram {
+	using Kind = NodeKinds;
+
+	public:
+		static constexpr size MAX_REGISTER = (1u << 31) - 1; // the largest id that still fits an operand with its flag
+
+		std::vector<FlatInst> instructions;
+		std::vector<FlatLabel> labels;
+		std::vector<FlatLiteral> literals;
+		std::vector<FlatDirective> directives;
+		std::vector<std::string_view> words;
+		std::vector<u32> extra;
+
+		FlatProgram() = default;
+		explicit FlatProgram(ProgNode* program);
+
+		auto body(const FlatLabel& label) const -> std::span<const FlatInst>;
+
+		// The count prefixed list an operand points at
+		auto list(FlatOperand op) const -> std::span<const u32>;
+
+		// Bytes held by the tables, for comparing against the tree
+		auto bytes() const -> size;
+
+		static auto is_data(FlatOperand op) -> bool { return op & 1; }
+		static auto reg_id(FlatOperand op) -> u32 { return op >> 1; }
+
+	private:
+		auto directive(DirectiveNode* directive) -> void;
+		auto instruction(Node* node) -> void;
+		auto reg(Node* node) -> FlatOperand;
+		auto literal(Node* node) -> FlatOperand;
+};
+
+}
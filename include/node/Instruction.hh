@@ -0,0 +1,232 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <node/Node.hh>
+
+#include <array>
+#include <vector>
+
+namespace hive::ir {
+
+enum class Operand : u8 {
+	NONE,
+	REG,     // virtual or data register
+	VREG,    // virtual register only
+	LITERAL,
+	REGS,    // registers up to the end of the line, each after a space
+};
+
+// What sits between the operands, every operand not covered here is after a single space
+enum class Layout : u8 {
+	SPACED,      // OP a b
+	COMMA,       // OP a, b
+	ARROW,       // OP a -> b
+	COMMA_ARROW, // OP a, b -> c
+	DOT,         // OP a.b
+};
+
+/**
+ * Every instruction as one row: its token, node kind, node class, the
+ * ICodegen hook it goes to, the layout and up to three operands.
+ *
+ * Parse, Printer, FlatProgram, the binary format and ICodegen all work off
+ * this list, so an opcode is a row here plus an InstructionNode for its
+ * class if it needs a new one. DATA lines are not here, they start with a
+ * register rather than an opcode.
+ */
+#define INSTRUCTION_LIST \
+	Inst(ADD, ADD_NODE, BiNode, add, COMMA_ARROW, REG, REG, VREG) \
+	Inst(SUBTRACT, SUB_NODE, BiNode, sub, COMMA_ARROW, REG, REG, VREG) \
+	Inst(DIVIDE, DIV_NODE, BiNode, div, COMMA_ARROW, REG, REG, VREG) \
+	Inst(MULTIPLY, MUL_NODE, BiNode, mul, COMMA_ARROW, REG, REG, VREG) \
+	Inst(AND, AND_NODE, BiNode, instruction, COMMA_ARROW, REG, REG, VREG) \
+	Inst(OR, OR_NODE, BiNode, instruction, COMMA_ARROW, REG, REG, VREG) \
+	Inst(XOR, XOR_NODE, BiNode, instruction, COMMA_ARROW, REG, REG, VREG) \
+	Inst(NOT, NOT_NODE, NotNode, instruction, ARROW, REG, REG, NONE) \
+	Inst(COMPARE_EQUALITY, COMPARE_EQUALITY_NODE, CompareNode, instruction, COMMA, REG, REG, NONE) \
+	Inst(COMPARE_LESS_THAN, COMPARE_LESS_THAN_NODE, CompareNode, instruction, COMMA, REG, REG, NONE) \
+	Inst(COMPARE_GREATER_THAN, COMPARE_GREATER_THAN_NODE, CompareNode, instruction, COMMA, REG, REG, NONE) \
+	Inst(JUMP, JUMP_NODE, JumpNode, instruction, COMMA, REG, REG, NONE) \
+	Inst(JUMP_IF, JUMP_IF_NODE, JumpNode, instruction, COMMA, REG, REG, NONE) \
+	Inst(JUMP_NOT_EQUAL, JUMP_NOT_EQUAL_NODE, JumpNode, instruction, COMMA, REG, REG, NONE) \
+	Inst(JUMP_EQUAL, JUMP_EQUAL_NODE, JumpNode, instruction, COMMA, REG, REG, NONE) \
+	Inst(RETURN, RETURN_NODE, ReturnNode, instruction, SPACED, REG, NONE, NONE) \
+	Inst(DEREF, DEREF_NODE, DerefNode, instruction, ARROW, REG, REG, NONE) \
+	Inst(POINTERTO, POINTER_TO_NODE, PointerToNode, instruction, SPACED, REG, REG, NONE) \
+	Inst(CALL, CALL_NODE, CallNode, instruction, DOT, LITERAL, LITERAL, REGS) \
+	Inst(STORE, STORE_NODE, StoreNode, instruction, ARROW, REG, REG, NONE) \
+	Inst(WRITE, WRITE_NODE, WriteNode, instruction, ARROW, REG, REG, NONE) \
+
+// The parts of an instruction node in table order, REGS goes into list
+struct InstructionOperands {
+	Token* ident = nullptr;
+	Node* nodes[3] = {};
+	std::vector<Node*> list;
+};
+
+/**
+ * Builds an instruction node from its operands and takes one apart again.
+ * One specialization per node class, the node classes name their fields
+ * after what they mean so this is where they meet the table.
+ */
+template <typename T>
+struct InstructionNode;
+
+template <>
+struct InstructionNode<BiNode> {
+	static auto make(Arena* arena, InstructionOperands& ops, NodeKinds kind) -> Node* { return arena->make<BiNode>(ops.ident, ops.nodes[0], ops.nodes[1], ops.nodes[2], kind); }
+	static auto operands(Node* node, InstructionOperands& ops) -> void {
+		auto inst = (BiNode*)node;
+		ops.ident = inst->ident; ops.nodes[0] = inst->in_1; ops.nodes[1] = inst->in_2; ops.nodes[2] = inst->out;
+	}
+};
+
+template <>
+struct InstructionNode<CompareNode> {
+	static auto make(Arena* arena, InstructionOperands& ops, NodeKinds kind) -> Node* { return arena->make<CompareNode>(ops.ident, ops.nodes[0], ops.nodes[1], kind); }
+	static auto operands(Node* node, InstructionOperands& ops) -> void {
+		auto inst = (CompareNode*)node;
+		ops.ident = inst->ident; ops.nodes[0] = inst->in_1; ops.nodes[1] = inst->in_2;
+	}
+};
+
+template <>
+struct InstructionNode<JumpNode> {
+	static auto make(Arena* arena, InstructionOperands& ops, NodeKinds kind) -> Node* { return arena->make<JumpNode>(ops.ident, ops.nodes[0], ops.nodes[1], kind); }
+	static auto operands(Node* node, InstructionOperands& ops) -> void {
+		auto inst = (JumpNode*)node;
+		ops.ident = inst->ident; ops.nodes[0] = inst->in_1; ops.nodes[1] = inst->in_2;
+	}
+};
+
+template <>
+struct InstructionNode<NotNode> {
+	static auto make(Arena* arena, InstructionOperands& ops, NodeKinds) -> Node* { return arena->make<NotNode>(ops.ident, ops.nodes[0], ops.nodes[1]); }
+	static auto operands(Node* node, InstructionOperands& ops) -> void {
+		auto inst = (NotNode*)node;
+		ops.ident = inst->ident; ops.nodes[0] = inst->in; ops.nodes[1] = inst->out;
+	}
+};
+
+template <>
+struct InstructionNode<ReturnNode> {
+	static auto make(Arena* arena, InstructionOperands& ops, NodeKinds) -> Node* { return arena->make<ReturnNode>(ops.ident, ops.nodes[0]); }
+	static auto operands(Node* node, InstructionOperands& ops) -> void {
+		auto inst = (ReturnNode*)node;
+		ops.ident = inst->ident; ops.nodes[0] = inst->reg;
+	}
+};
+
+template <>
+struct InstructionNode<DerefNode> {
+	static auto make(Arena* arena, InstructionOperands& ops, NodeKinds) -> Node* { return arena->make<DerefNode>(ops.ident, ops.nodes[0], ops.nodes[1]); }
+	static auto operands(Node* node, InstructionOperands& ops) -> void {
+		auto inst = (DerefNode*)node;
+		ops.ident = inst->ident; ops.nodes[0] = inst->reg; ops.nodes[1] = inst->out;
+	}
+};
+
+template <>
+struct InstructionNode<PointerToNode> {
+	static auto make(Arena* arena, InstructionOperands& ops, NodeKinds) -> Node* { return arena->make<PointerToNode>(ops.ident, ops.nodes[0], ops.nodes[1]); }
+	static auto operands(Node* node, InstructionOperands& ops) -> void {
+		auto inst = (PointerToNode*)node;
+		ops.ident = inst->ident; ops.nodes[0] = inst->reg; ops.nodes[1] = inst->out;
+	}
+};
+
+template <>
+struct InstructionNode<CallNode> {
+	static auto make(Arena* arena, InstructionOperands& ops, NodeKinds) -> Node* { return arena->make<CallNode>(ops.ident, ops.nodes[0], ops.nodes[1], std::move(ops.list)); }
+	static auto operands(Node* node, InstructionOperands& ops) -> void {
+		auto inst = (CallNode*)node;
+		ops.ident = inst->ident; ops.nodes[0] = inst->lib; ops.nodes[1] = inst->function; ops.list = inst->params;
+	}
+};
+
+template <>
+struct InstructionNode<StoreNode> {
+	static auto make(Arena* arena, InstructionOperands& ops, NodeKinds) -> Node* { return arena->make<StoreNode>(ops.ident, ops.nodes[0], ops.nodes[1]); }
+	static auto operands(Node* node, InstructionOperands& ops) -> void {
+		auto inst = (StoreNode*)node;
+		ops.ident = inst->ident; ops.nodes[0] = inst->value; ops.nodes[1] = inst->reg;
+	}
+};
+
+template <>
+struct InstructionNode<WriteNode> {
+	static auto make(Arena* arena, InstructionOperands& ops, NodeKinds) -> Node* { return arena->make<WriteNode>(ops.ident, ops.nodes[0], ops.nodes[1]); }
+	static auto operands(Node* node, InstructionOperands& ops) -> void {
+		auto inst = (WriteNode*)node;
+		ops.ident = inst->ident; ops.nodes[0] = inst->value; ops.nodes[1] = inst->reg;
+	}
+};
+
+struct InstructionDesc {
+	TokenKind token;
+	NodeKinds node;
+	Layout layout;
+	Operand operands[3];
+	u8 count;
+
+	auto (*make)(Arena* arena, InstructionOperands& ops, NodeKinds kind) -> Node*;
+	auto (*operands_of)(Node* node, InstructionOperands& ops) -> void;
+
+	constexpr auto comma() const -> bool { return layout == Layout::COMMA || layout == Layout::COMMA_ARROW; }
+	constexpr auto arrow() const -> bool { return layout == Layout::ARROW || layout == Layout::COMMA_ARROW; }
+
+	// The separator before operand i that is not just a space, if any
+	constexpr auto before(u8 i) const -> TokenKind {
+		if (i == 1 && comma()) return TokenKind::COMMA;
+		if (i == 1 && layout == Layout::DOT) return TokenKind::DOT;
+		if (i + 1 == count && arrow()) return TokenKind::RIGHT_ARROW;
+		return TokenKind::SPACE;
+	}
+};
+
+constexpr auto operand_count(Operand a, Operand b, Operand c) -> u8 {
+	return (a != Operand::NONE) + (b != Operand::NONE) + (c != Operand::NONE);
+}
+
+constexpr InstructionDesc instruction_table[] = {
+	#define Inst(token, node, cls, hook, layout, a, b, c) { \
+		TokenKind::token, NodeKinds::node, Layout::layout, {Operand::a, Operand::b, Operand::c}, operand_count(Operand::a, Operand::b, Operand::c), \
+		&InstructionNode<cls>::make, &InstructionNode<cls>::operands \
+	},
+		INSTRUCTION_LIST
+	#undef Inst
+};
+
+constexpr size INSTRUCTION_COUNT = sizeof(instruction_table) / sizeof(instruction_table[0]);
+constexpr u8 NO_INSTRUCTION = 0xFF;
+
+// Row of the table for a token or node kind, NO_INSTRUCTION if it has none
+constexpr auto instruction_by_token = [] {
+	std::array<u8, 256> rows{};
+	rows.fill(NO_INSTRUCTION);
+	for (size i = 0; i < INSTRUCTION_COUNT; i++) rows[(u8)instruction_table[i].token] = i;
+	return rows;
+}();
+
+constexpr auto instruction_by_node = [] {
+	std::array<u8, 256> rows{};
+	rows.fill(NO_INSTRUCTION);
+	for (size i = 0; i < INSTRUCTION_COUNT; i++) rows[(u8)instruction_table[i].node] = i;
+	return rows;
+}();
+
+constexpr auto find_instruction(TokenKind kind) -> const InstructionDesc* {
+	auto row = instruction_by_token[(u8)kind];
+	return row == NO_INSTRUCTION ? nullptr : &instruction_table[row];
+}
+
+constexpr auto find_instruction(NodeKinds kind) -> const InstructionDesc* {
+	auto row = instruction_by_node[(u8)kind];
+	return row == NO_INSTRUCTION ? nullptr : &instruction_table[row];
+}
+
+}
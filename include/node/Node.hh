@@ -7,6 +7,9 @@
 
 #include <node/NodeKind.hh>
 #include <token/Token.hh>
+#include <util/Arena.hh>
+
+#include <utility>
 #include <vector>
 
 namespace hive::ir {
@@ -26,6 +29,7 @@ class HexLiteralNode;
 class DigitLiteralNode;
 class OctalLiteralNode;
 class BinaryLiteralNode;
+class FloatLiteralNode;
 
 class LabelNode;
 class FuncNode;
@@ -52,9 +56,11 @@ class TypeNode;
 class ProgNode {
 	public:
 		std::vector<Node*> nodes;
+		Arena* arena;
 
-		ProgNode(std::vector<Node*> nodes) {
-			this->nodes = nodes;
+		ProgNode(std::vector<Node*> nodes, Arena* arena) {
+			this->nodes = std::move(nodes);
+			this->arena = arena;
 		}
 };
 
@@ -66,7 +72,8 @@ class Node {
 
 	public:
 		Kind kind;
-		std::string node_name;
+
+		auto node_name() const -> std::string_view { return name_from_node(kind); }
 
 		virtual auto to_string() -> std::string = 0;
 };
@@ -91,7 +98,7 @@ class DataRegisterNode : public Node {
 		Token* ident;
 		size id;
 
-		DataRegisterNode(Token* ident, size id) : Node(Kind::VIRTUAL_REGISTER_NODE) {
+		DataRegisterNode(Token* ident, size id) : Node(Kind::DATA_REGISTER_NODE) {
 			this->ident = ident;
 			this->id    = id;
 		}
@@ -110,7 +117,7 @@ class DirectiveNode : public Node {
 		DirectiveNode(Token* ident, Node* name, std::vector<Token*> tokens) : Node(Kind::DIRECTIVE_NODE) {
 			this->ident  = ident;
 			this->name   = name;
-			this->tokens = tokens;
+			this->tokens = std::move(tokens);
 		}
 
 		auto to_string() -> std::string override {
@@ -144,7 +151,9 @@ class StringLiteralNode : public Node {
 		Token* end;
 
 		StringLiteralNode(Token* start, Token* ident, Token* end) : Node(Kind::STRING_LITERAL_NODE) {
+			this->start = start;
 			this->ident = ident;
+			this->end   = end;
 		}
 
 		auto to_string() -> std::string override {
@@ -155,9 +164,11 @@ class StringLiteralNode : public Node {
 class HexLiteralNode : public Node {
 	public:
 		Token* ident;
+		u64 value; // decoded by the lexer
 
 		HexLiteralNode(Token* ident) : Node(Kind::HEX_LITERAL_NODE) {
 			this->ident = ident;
+			this->value = ident->value.integer;
 		}
 
 		auto to_string() -> std::string override {
@@ -168,9 +179,11 @@ class HexLiteralNode : public Node {
 class DigitLiteralNode : public Node {
 	public:
 		Token* ident;
+		u64 value; // decoded by the lexer
 
 		DigitLiteralNode(Token* ident) : Node(Kind::DIGIT_LITERAL_NODE) {
 			this->ident = ident;
+			this->value = ident->value.integer;
 		}
 
 		auto to_string() -> std::string override {
@@ -181,9 +194,11 @@ class DigitLiteralNode : public Node {
 class OctalLiteralNode : public Node {
 	public:
 		Token* ident;
+		u64 value; // decoded by the lexer
 
 		OctalLiteralNode(Token* ident) : Node(Kind::OCTAL_LITERAL_NODE) {
 			this->ident = ident;
+			this->value = ident->value.integer;
 		}
 
 		auto to_string() -> std::string override {
@@ -194,9 +209,26 @@ class OctalLiteralNode : public Node {
 class BinaryLiteralNode : public Node {
 	public:
 		Token* ident;
+		u64 value; // decoded by the lexer
 
 		BinaryLiteralNode(Token* ident) : Node(Kind::BINARY_LITERAL_NODE) {
 			this->ident = ident;
+			this->value = ident->value.integer;
+		}
+
+		auto to_string() -> std::string override {
+			return fmt::format("{}", ident->name);
+		}
+};
+
+class FloatLiteralNode : public Node {
+	public:
+		Token* ident;
+		double value; // decoded by the lexer
+
+		FloatLiteralNode(Token* ident) : Node(Kind::FLOAT_LITERAL_NODE) {
+			this->ident = ident;
+			this->value = ident->value.real;
 		}
 
 		auto to_string() -> std::string override {
@@ -213,7 +245,7 @@ class LabelNode : public Node {
 		LabelNode(Token* ident, Node* name, std::vector<Node*> instructions) : Node(Kind::LABEL_NODE) {
 			this->ident = ident;
 			this->name = name;
-			this->instructions = instructions;
+			this->instructions = std::move(instructions);
 		}
 
 		auto to_string() -> std::string override {
@@ -230,7 +262,7 @@ class FuncNode : public Node {
 		FuncNode(Token* ident, Token* name, std::vector<Node*> registers) : Node(Kind::FUNCTION_NODE) {
 			this->ident     = ident;
 			this->name      = name;
-			this->registers = registers;
+			this->registers = std::move(registers);
 		}
 
 		auto to_string() -> std::string override {
@@ -349,7 +381,7 @@ class PointerToNode : public Node {
 		Node* reg;
 		Node* out;
 
-		PointerToNode(Token* ident, Node* reg, Node* out) : Node(Kind::DEREF_NODE) {
+		PointerToNode(Token* ident, Node* reg, Node* out) : Node(Kind::POINTER_TO_NODE) {
 			this->ident = ident;
 			this->reg   = reg;
 			this->out   = out;
@@ -371,7 +403,7 @@ class CallNode : public Node {
 			this->ident    = ident;
 			this->lib      = lib;
 			this->function = function;
-			this->params   = params;
+			this->params   = std::move(params);
 		}
 
 		auto to_string() -> std::string override {
@@ -448,7 +480,7 @@ class DataTypeNode : public Node {
 		DataTypeNode(Node* d_reg, Token* start, std::vector<Node*> types, Token* end) : Node(Kind::DATA_TYPE_NODE) {
 			this->data_register = d_reg;
 			this->start         = start;
-			this->types         = types;
+			this->types         = std::move(types);
 			this->end           = end;
 		}
 
@@ -470,14 +502,14 @@ class DataStructNode : public Node {
 		Token* ident;
 		Node* literal;
 
-		DataStructNode(Node* data_register, Token* ident, Node* literal) : Node(Kind::DATA_STATIC_NODE) {
+		DataStructNode(Node* data_register, Token* ident, Node* literal) : Node(Kind::DATA_STRUCT_NODE) {
 			this->data_register = data_register;
 			this->ident         = ident;
 			this->literal       = literal;
 		}
 
 		auto to_string() -> std::string override {
-			return fmt::format("{} {} -> {}", data_register->to_string(), ident->to_string(), literal->to_string());
+			return fmt::format("{} {} -> {}", data_register->to_string(), ident->name, literal->to_string());
 		}
 };
 
@@ -491,7 +523,7 @@ class TypeNode : public Node {
 
 
 		auto to_string() -> std::string override {
-			return ident->name;
+			return std::string(ident->name);
 		}
 };
 }
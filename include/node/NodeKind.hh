@@ -7,7 +7,8 @@
 #pragma once
 
 #include <Defs.hh>
-#include <map>
+
+#include <string_view>
 
 namespace hive::ir {
 
@@ -28,7 +29,7 @@ namespace hive::ir {
 	_Node(COMPARE_EQUALITY_NODE, "COMPARE_EQUALITY_NODE") \
 	_Node(COMPARE_LESS_THAN_NODE, "COMPARE_LESS_THAN_NODE") \
 	_Node(COMPARE_GREATER_THAN_NODE, "COMPARE_GREATER_THAN_NODE") \
-	_Node(JUMP_NODE, "JUMP_IF_NODE") \
+	_Node(JUMP_NODE, "JUMP_NODE") \
 	_Node(JUMP_IF_NODE, "JUMP_IF_NODE") \
 	_Node(JUMP_NOT_EQUAL_NODE, "JUMP_NOT_EQUAL_NODE") \
 	_Node(JUMP_EQUAL_NODE, "JUMP_EQUAL_NODE") \
@@ -65,16 +66,15 @@ namespace hive::ir {
 	_Node(DATA_REGISTER_NODE, "REGISTER_NODE") \
 	_Node(DIRECTIVE_NODE, "DIRECTIVE_NODE") \
 
-}
-
 enum class NodeKinds : u8 {
 	#define _Node(kind, name) kind,
 		NODE_KIND_NAME_LIST
 	#undef _Node
 };
 
-const std::map<NodeKinds, std::string> node_name_map =  {
-	#define _Node(kind, name) {NodeKinds::kind, name},
-		NODE_KIND_NAME_LIST
-	#undef _Node
-};
+auto name_from_node(NodeKinds kind) -> std::string_view;
+
+// Reverse of name_from_node, INVALID for anything that is not a node name
+auto node_from_name(std::string_view name) -> NodeKinds;
+
+}
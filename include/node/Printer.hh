@@ -0,0 +1,54 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <node/Node.hh>
+#include <node/Instruction.hh>
+#include <node/Visitor.hh>
+
+#include <string>
+
+namespace hive::ir {
+
+/**
+ * Prints a program back out as .hir text that Parse accepts. Unlike the
+ * per node to_string this is meant to round trip, so it follows the layout
+ * rules exactly: one tab before instructions, single spaces between operands.
+ */
+class Printer : public NodeVisitor<Printer> {
+	friend class NodeVisitor<Printer>;
+
+	public:
+		auto print(ProgNode* program) -> std::string;
+		auto print(Node* node) -> std::string;
+
+	private:
+		std::string out;
+
+	private:
+		auto visit(LabelNode* label) -> void;
+		auto visit(DirectiveNode* directive) -> void;
+
+		auto visit(StringLiteralNode* node) -> void;
+		auto visit(IdentLiteralNode* node) -> void;
+		auto visit(HexLiteralNode* node) -> void;
+		auto visit(DigitLiteralNode* node) -> void;
+		auto visit(OctalLiteralNode* node) -> void;
+		auto visit(BinaryLiteralNode* node) -> void;
+		auto visit(FloatLiteralNode* node) -> void;
+
+		auto visit(VirtualRegisterNode* node) -> void;
+		auto visit(DataRegisterNode* node) -> void;
+
+		auto visit(DataStaticNode* data) -> void;
+		auto visit(DataTypeNode* data) -> void;
+
+		auto visit(Node* node) -> void;
+		auto instruction(Node* node, const InstructionDesc& desc) -> void;
+};
+
+}
@@ -0,0 +1,49 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <node/Node.hh>
+#include <util/Arena.hh>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace hive::ir {
+
+/**
+ * One canonical node per register of a module, so every use of r3 is the
+ * same VirtualRegisterNode and "same register" is a pointer compare. Info a
+ * pass works out about a register can be hung off that one node.
+ *
+ * Safe to share between threads, callers on a hot path should keep their
+ * own cache in front of it like Parse does.
+ */
+class RegisterTable {
+	public:
+		RegisterTable();
+
+		RegisterTable(const RegisterTable&) = delete;
+		auto operator=(const RegisterTable&) -> RegisterTable& = delete;
+
+		auto virtual_register(size id) -> VirtualRegisterNode*;
+		auto data_register(size id) -> DataRegisterNode*;
+
+		auto count() const -> size;
+
+		// Drops every register node, the storage stays allocated for reuse
+		auto clear() -> void;
+
+	private:
+		mutable std::mutex lock;
+		Arena storage;
+		std::unordered_map<size, VirtualRegisterNode*> virtuals;
+		std::unordered_map<size, DataRegisterNode*> datas;
+
+	private:
+		auto token(TokenKind kind, char prefix, size id) -> Token*;
+};
+
+}
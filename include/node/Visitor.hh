@@ -0,0 +1,90 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <node/Node.hh>
+
+namespace hive::ir {
+
+// The class behind every concrete NodeKinds, kinds not listed here go to visit(Node*)
+#define NODE_CLASS_LIST \
+	_Visit(ADD_NODE, BiNode) \
+	_Visit(SUB_NODE, BiNode) \
+	_Visit(DIV_NODE, BiNode) \
+	_Visit(MUL_NODE, BiNode) \
+	_Visit(AND_NODE, BiNode) \
+	_Visit(OR_NODE, BiNode) \
+	_Visit(XOR_NODE, BiNode) \
+	_Visit(NOT_NODE, NotNode) \
+	_Visit(LABEL_NODE, LabelNode) \
+	_Visit(COMPARE_EQUALITY_NODE, CompareNode) \
+	_Visit(COMPARE_LESS_THAN_NODE, CompareNode) \
+	_Visit(COMPARE_GREATER_THAN_NODE, CompareNode) \
+	_Visit(JUMP_NODE, JumpNode) \
+	_Visit(JUMP_IF_NODE, JumpNode) \
+	_Visit(JUMP_NOT_EQUAL_NODE, JumpNode) \
+	_Visit(JUMP_EQUAL_NODE, JumpNode) \
+	_Visit(FUNCTION_NODE, FuncNode) \
+	_Visit(RETURN_NODE, ReturnNode) \
+	_Visit(DEREF_NODE, DerefNode) \
+	_Visit(POINTER_TO_NODE, PointerToNode) \
+	_Visit(CALL_NODE, CallNode) \
+	_Visit(STORE_NODE, StoreNode) \
+	_Visit(WRITE_NODE, WriteNode) \
+	_Visit(DATA_STATIC_NODE, DataStaticNode) \
+	_Visit(DATA_STRUCT_NODE, DataStructNode) \
+	_Visit(DATA_TYPE_NODE, DataTypeNode) \
+	_Visit(STRING_LITERAL_NODE, StringLiteralNode) \
+	_Visit(IDENT_LITERAL_NODE, IdentLiteralNode) \
+	_Visit(BINARY_LITERAL_NODE, BinaryLiteralNode) \
+	_Visit(FLOAT_LITERAL_NODE, FloatLiteralNode) \
+	_Visit(HEX_LITERAL_NODE, HexLiteralNode) \
+	_Visit(DIGIT_LITERAL_NODE, DigitLiteralNode) \
+	_Visit(OCTAL_LITERAL_NODE, OctalLiteralNode) \
+	_Visit(I8_TYPE_NODE, TypeNode) \
+	_Visit(I16_TYPE_NODE, TypeNode) \
+	_Visit(I32_TYPE_NODE, TypeNode) \
+	_Visit(I64_TYPE_NODE, TypeNode) \
+	_Visit(VIRTUAL_REGISTER_NODE, VirtualRegisterNode) \
+	_Visit(DATA_REGISTER_NODE, DataRegisterNode) \
+	_Visit(DIRECTIVE_NODE, DirectiveNode) \
+
+/**
+ * Static dispatch over Node::kind. dispatch() switches on the kind and
+ * calls Derived::visit with the node cast to its class, so the handlers are
+ * plain member calls the compiler can inline instead of virtual ones.
+ *
+ *   class Counter : public NodeVisitor<Counter, size> {
+ *       public:
+ *           using NodeVisitor::visit;
+ *           auto visit(BiNode* node) -> size { return 1; }
+ *           auto visit(Node* node) -> size { return 0; }
+ *   };
+ *
+ * Overloads Derived does not have fall back to visit(Node*), which Derived
+ * can define itself or take from here with the using.
+ */
+template <typename Derived, typename R = void>
+class NodeVisitor {
+	public:
+		auto dispatch(Node* node) -> R {
+			auto self = static_cast<Derived*>(this);
+
+			switch (node->kind) {
+				#define _Visit(kind, cls) case NodeKinds::kind: return self->visit((cls*)node);
+					NODE_CLASS_LIST
+				#undef _Visit
+				default: return self->visit(node);
+			}
+		}
+
+		auto visit(Node* node) -> R {
+			Panic(fmt::format("No visit for {}", node->to_string()))
+			return R();
+		}
+};
+
+}
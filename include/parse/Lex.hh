@@ -7,29 +7,60 @@
 
 #include <Defs.hh>
 #include <token/Token.hh>
+#include <token/TokenBuffer.hh>
+#include <parse/Scan.hh>
+#include <parse/SourceBuffer.hh>
+#include <Context.hh>
+#include <err/Diagnostic.hh>
 
-#include <vector>
 
 namespace hive::ir {
 
 enum class LexMode : u8 {
-	TEXT,
+	TEXT,        // blanks are SPACE/TAB tokens
+	TRIVIA_FREE, // blanks are folded into the trivia of the next token
 	BINARY,
 };
 
+/**
+ * Pull based lexer, tokens are scanned as next() is called so the whole
+ * token list never exists at once. They go into a TokenBuffer in their
+ * compact form and only become a Token, and end up in the arena, when the
+ * parser keeps them.
+ */
 class Lex {
 	using Kind = TokenKind;
 
 	public:
-		std::vector<Token*> tokens;
+		Context* ctx;
+		Arena* arena; // where consumers of this lexer allocate
+		LexMode mode;
+
+		Lex(const char* target, LexMode mode, Context* ctx);
+
+		// Lexes [begin, end) of a file already in ctx, consumers allocate into arena. Used by ParallelParse
+		Lex(Context* ctx, FileId file, size begin, size end, Arena* arena, LexMode mode);
+
+		// Appends the next token to out, a string literal appends all three of its tokens. _EOF once the end is reached
+		auto next(TokenBuffer& out) -> void;
+
+		// Expands slot n of tokens with its text and position
+		auto token(const TokenBuffer& tokens, size n) -> Token;
 
-		Lex(const char* target, LexMode mode);
+		// Just the text of slot n, without building a Token
+		auto name(const TokenBuffer& tokens, size n) -> std::string_view;
 	private:
 		std::string target;
-		char* buffer;
-		size idx;
-		size line = 1;
-		size column = 1;
+		FileId file;
+		const char* buffer;
+		const ScanKernels* scan = &scan_kernels();
+		size idx = 0;
+		size limit = 0;
+
+		TokenBuffer* out = nullptr;
+		Trivia blank = Trivia::NONE; // goes on the next token made
+		u32 blank_width = 0;
+		bool at_start = false;
 	private:
 		auto peek(i8 n) -> char;
 		auto peek() -> char;
@@ -37,27 +68,25 @@ class Lex {
 		auto check(i8 n, char c) -> bool;
 		auto check(char c) -> bool;
 
-		auto advance(i8 n) -> void;
+		auto advance(size n) -> void;
 		auto advance() -> void;
+		auto advance_to(const char* end) -> void;
+		auto last_at(const char* end) -> void;
 
-		auto scan_token() -> Token*;
+		auto start(size begin, size end) -> void;
+		auto scan_token() -> void;
+		auto scan_trivia() -> void;
 
-	private:
-		auto concat_string() -> std::string;
-
-		auto concat_number() -> Token*;
-		auto concat_ident() -> Token*;
+		auto text(size start) -> std::string_view;
+		auto make_token(Kind kind, size start, u64 value = 0) -> void;
+		auto make_number(Kind kind, size start) -> void;
 
-		auto is_hex() -> bool;
-		auto is_digit() -> bool;
-		auto is_octal() -> bool;
-		auto is_binary() -> bool;
-
-		auto is_alpha() -> bool;
-		auto is_alpha_num() -> bool;
-		auto is_ident() -> bool;
+	private:
+		auto concat_string() -> void;
+		auto concat_word() -> void;
 
-		auto lex_error(std::string msg) -> void;
+		auto where(size offset) -> std::string;
+		[[noreturn]] auto lex_error(std::string msg) -> void;
 		auto load_target(const char* f) -> void;
 };
 
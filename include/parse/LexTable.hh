@@ -0,0 +1,209 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <Defs.hh>
+#include <token/TokenKind.hh>
+
+#include <array>
+
+namespace hive::ir {
+
+/**
+ * Tables behind Lex::scan_token, all of them built at compile time.
+ *
+ * Every byte has a CharClass. Single char tokens come straight out of
+ * TOKEN_PUNCT_LIST. Words (identifiers, keywords, registers and numbers)
+ * run through a small DFA, one table load per byte, until it steps to DONE.
+ * The state it stopped in says what kind of token the word is.
+ */
+enum class CharClass : u8 {
+	INVALID,
+	END,   // \0
+	BLANK,
+	EOL,
+	QUOTE,
+	DASH,  // - or the start of ->
+	PUNCT,
+
+	// everything from here on can be part of a word
+	ZERO,
+	ONE,
+	OCTAL,      // 2-7
+	DIGIT,      // 8-9
+	HEX_LETTER, // a-f and A-F, other than b and d
+	B,
+	D,
+	O,
+	R,
+	X,
+	LETTER,
+	UNDERSCORE,
+	DOT,        // only part of a word inside a number
+
+	COUNT,
+};
+
+enum class LexState : u8 {
+	START,
+	IDENT,
+	REGISTER,    // r
+	REGISTER_ID, // r and digits
+	DATA,        // d
+	DATA_ID,     // d and digits
+	ZERO,
+	DIGITS,
+	FLOAT,
+	HEX,
+	BINARY,
+	OCTAL,
+
+	// stop states, the current char is not part of the word
+	DONE,
+	BAD_FLOAT, // a second dot in a number
+
+	COUNT,
+};
+
+namespace lex_table {
+
+constexpr auto punct_kinds = [] {
+	std::array<TokenKind, 256> kinds{};
+	kinds.fill(TokenKind::_EOF);
+
+	#define Punct(c, kind) kinds[(u8)c] = TokenKind::kind;
+		TOKEN_PUNCT_LIST
+	#undef Punct
+	return kinds;
+}();
+
+constexpr auto classify(u8 c) -> CharClass {
+	using C = CharClass;
+
+	switch (c) {
+		case '\0': return C::END;
+		case ' ':
+		case '\t': return C::BLANK;
+		case '\n': return C::EOL;
+		case '"': return C::QUOTE;
+		case '-': return C::DASH;
+		case '.': return C::DOT;
+		case '_': return C::UNDERSCORE;
+		case '0': return C::ZERO;
+		case '1': return C::ONE;
+		case 'b': return C::B;
+		case 'd': return C::D;
+		case 'o': return C::O;
+		case 'r': return C::R;
+		case 'x': return C::X;
+	}
+
+	if (c >= '2' && c <= '7') return C::OCTAL;
+	if (c == '8' || c == '9') return C::DIGIT;
+	if ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')) return C::HEX_LETTER;
+	if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) return C::LETTER;
+	if (punct_kinds[c] != TokenKind::_EOF) return C::PUNCT;
+	return C::INVALID;
+}
+
+constexpr auto char_classes = [] {
+	std::array<CharClass, 256> classes{};
+	for (size c = 0; c < 256; c++) classes[c] = classify((u8)c);
+	return classes;
+}();
+
+constexpr auto is_word(CharClass c) -> bool { return CharClass::ZERO <= c && c <= CharClass::UNDERSCORE; }
+constexpr auto is_digit(CharClass c) -> bool { return CharClass::ZERO <= c && c <= CharClass::DIGIT; }
+constexpr auto is_octal(CharClass c) -> bool { return CharClass::ZERO <= c && c <= CharClass::OCTAL; }
+constexpr auto is_binary(CharClass c) -> bool { return c == CharClass::ZERO || c == CharClass::ONE; }
+constexpr auto is_hex(CharClass c) -> bool { return is_digit(c) || c == CharClass::HEX_LETTER || c == CharClass::B || c == CharClass::D; }
+
+/**
+ * One step of the word DFA. r and d followed only by digits are registers,
+ * any other letter after them makes the whole word an identifier.
+ */
+constexpr auto step(LexState state, CharClass c) -> LexState {
+	using S = LexState;
+	using C = CharClass;
+
+	switch (state) {
+		case S::START: {
+			if (c == C::ZERO) return S::ZERO;
+			if (is_digit(c)) return S::DIGITS;
+			if (c == C::R) return S::REGISTER;
+			if (c == C::D) return S::DATA;
+			return is_word(c) ? S::IDENT : S::DONE;
+		}
+		case S::IDENT: return is_word(c) ? S::IDENT : S::DONE;
+		case S::REGISTER:
+		case S::REGISTER_ID: {
+			if (is_digit(c)) return S::REGISTER_ID;
+			return is_word(c) ? S::IDENT : S::DONE;
+		}
+		case S::DATA:
+		case S::DATA_ID: {
+			if (is_digit(c)) return S::DATA_ID;
+			return is_word(c) ? S::IDENT : S::DONE;
+		}
+		case S::ZERO: {
+			if (c == C::X) return S::HEX;
+			if (c == C::B) return S::BINARY;
+			if (c == C::O) return S::OCTAL;
+			[[fallthrough]];
+		}
+		case S::DIGITS: {
+			if (is_digit(c)) return S::DIGITS;
+			return c == C::DOT ? S::FLOAT : S::DONE;
+		}
+		case S::FLOAT: {
+			if (is_digit(c)) return S::FLOAT;
+			return c == C::DOT ? S::BAD_FLOAT : S::DONE;
+		}
+		case S::HEX: return is_hex(c) ? S::HEX : S::DONE;
+		case S::BINARY: return is_binary(c) ? S::BINARY : S::DONE;
+		case S::OCTAL: return is_octal(c) ? S::OCTAL : S::DONE;
+		default: return S::DONE;
+	}
+}
+
+// Note: Indexed by byte rather than CharClass so the inner loop is a single load
+constexpr auto transitions = [] {
+	std::array<std::array<LexState, 256>, (size)LexState::COUNT> table{};
+	for (size s = 0; s < (size)LexState::COUNT; s++) {
+		for (size c = 0; c < 256; c++) table[s][c] = step((LexState)s, char_classes[c]);
+	}
+	return table;
+}();
+
+// Kind of the word that ended in state, IDENT_LITERAL still goes through kind_from_name for keywords
+constexpr auto accept_kind(LexState state) -> TokenKind {
+	using S = LexState;
+
+	switch (state) {
+		case S::IDENT: return TokenKind::IDENT_LITERAL;
+		case S::REGISTER:
+		case S::REGISTER_ID: return TokenKind::REGISTER;
+		case S::DATA:
+		case S::DATA_ID: return TokenKind::DATA;
+		case S::ZERO:
+		case S::DIGITS: return TokenKind::DIGIT_LITERAL;
+		case S::FLOAT: return TokenKind::FLOAT_LITERAL;
+		case S::HEX: return TokenKind::HEX_LITERAL;
+		case S::BINARY: return TokenKind::BINARY_LITERAL;
+		case S::OCTAL: return TokenKind::OCTAL_LITERAL;
+		default: return TokenKind::_EOF;
+	}
+}
+
+static_assert(transitions[(size)LexState::START][(u8)'r'] == LexState::REGISTER);
+static_assert(transitions[(size)LexState::REGISTER][(u8)'e'] == LexState::IDENT);
+static_assert(transitions[(size)LexState::ZERO][(u8)'x'] == LexState::HEX);
+static_assert(transitions[(size)LexState::FLOAT][(u8)'.'] == LexState::BAD_FLOAT);
+static_assert(char_classes[(u8)'('] == CharClass::PUNCT && punct_kinds[(u8)'('] == TokenKind::OPEN_PARAN);
+
+}
+
+}
@@ -0,0 +1,67 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <parse/SourceBuffer.hh>
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace hive::ir {
+
+// A LABEL line up to the next one (or the directives before the first) and the text it prints as
+struct Segment {
+	u64 hash; // ModuleState::hash of the segment's source bytes
+	std::string_view text;
+};
+
+/**
+ * What the last compile of a module produced, one Segment per top level
+ * LABEL group in source order. A segment prints the same no matter what is
+ * around it, CALL and JUMP targets are printed by name, so a segment whose
+ * bytes hash the same can reuse its text without being parsed.
+ *
+ * The state file is
+ *
+ *   "HIRS", u32 version, u64 segment count,
+ *   segment count * (u64 hash, u64 text length, text bytes)
+ *
+ * and is read through a mapping, reused text points straight into it.
+ */
+class ModuleState {
+	public:
+		static constexpr char MAGIC[4]   = {'H', 'I', 'R', 'S'};
+		static constexpr u32 VERSION     = 1;
+
+		std::vector<Segment> segments;
+
+		// Seeded with the build, a state written by another hir never matches
+		static auto hash(std::string_view source) -> u64;
+
+		// A missing or unreadable file is an empty state, everything gets parsed
+		auto load(const char* path) -> void;
+		auto find(u64 hash) const -> const Segment*;
+
+		// Adds a segment whose text this state has to own
+		auto add(u64 hash, std::string text) -> void;
+
+		// Adds a segment of another state, which has to outlive this one
+		auto reuse(const Segment& segment) -> void;
+
+		// Written next to path and renamed over it, a state mapped from path stays valid
+		auto save(const char* path) const -> bool;
+
+	private:
+		SourceBuffer file;
+		std::unordered_map<u64, u32> by_hash; // index into segments
+		std::deque<std::string> owned;
+};
+
+}
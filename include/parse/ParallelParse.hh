@@ -0,0 +1,70 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <parse/Parse.hh>
+#include <util/ThreadPool.hh>
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace hive::ir {
+
+/**
+ * Front end that lexes and parses top level LABEL groups on several threads.
+ *
+ * A cheap pre scan, itself split over the threads, finds every line
+ * starting with LABEL outside of a string.
+ * Everything before the first one holds the directives and is parsed on the
+ * calling thread. The labels are cut into chunks that each get their own Lex,
+ * Parse and arena on the pool, and the results are stitched back together in
+ * source order with the chunk arenas adopted by the context's arena.
+ */
+class ParallelParse {
+	public:
+		// Below this many bytes per chunk the work is not worth a thread
+		static constexpr size MIN_CHUNK_BYTES = 256 * 1024;
+
+		ParallelParse(const char* target, Context* ctx, size threads);
+
+		auto construct() -> ProgNode*;
+
+		// [begin, end) of the directives before the first LABEL, if any, and of every top level LABEL group
+		auto segments() -> std::vector<std::pair<size, size>>;
+
+		// Parses one segment on the calling thread into the context's arena
+		auto parse_segment(std::pair<size, size> segment) -> ProgNode*;
+
+		auto source() const -> std::string_view { return std::string_view(buffer, length); }
+
+	private:
+		struct Boundary {
+			size offset;
+		};
+
+		// A newline aligned slice of the buffer for the pre scan
+		struct ScanPart {
+			size begin;
+			size end;
+			size quotes = 0;
+			std::vector<Boundary> starts[2]; // LABEL lines if the part begins outside / inside a string
+		};
+
+		Context* ctx;
+		FileId file;
+		size threads;
+		const char* buffer;
+		size length;
+
+	private:
+		auto label_starts(ThreadPool* pool) -> std::vector<Boundary>;
+		auto scan_part(ScanPart& part) -> void;
+		[[noreturn]] auto parse_error(std::string msg) -> void;
+};
+
+}
@@ -8,8 +8,9 @@
 
 #include <parse/Lex.hh>
 #include <node/Node.hh>
+#include <node/Instruction.hh>
 
-#include <err/ErrorCodes.hh>
+#include <err/Diagnostic.hh>
 
 namespace hive::ir {
 
@@ -18,7 +19,19 @@ class Parse {
 		using Kind  = TokenKind;
 		using Error = ErrorCode;
 		Lex* lex;
+		Arena* arena;
 		size idx = -1;
+		bool trivia_free; // blanks come as trivia on tokens instead of SPACE/TAB tokens
+
+		TokenBuffer tokens;
+
+		// Note: Registers come from ctx->registers, small ids are cached here so most uses never take its lock
+		static constexpr size REGISTER_CACHE = 1024;
+		std::vector<VirtualRegisterNode*> virtuals;
+		std::vector<DataRegisterNode*> datas;
+
+		std::vector<Node*> body; // instructions of the label being parsed
+		std::vector<Node*> regs; // the REGS operand of the instruction being parsed
 
 	public:
 		Parse(Lex* lex);
@@ -36,6 +49,7 @@ class Parse {
 		auto reg() -> Node*;
 		auto v_register() -> Node*;
 		auto d_register() -> Node*;
+		auto register_id(Kind kind) -> size;
 
 		auto type() -> Node*;
 
@@ -45,31 +59,35 @@ class Parse {
 		auto data_types() -> Node*;
 		auto data_static() -> Node*;
 
-		auto bi_node() -> Node*;
-		auto compare() -> Node*;
-		auto jump() -> Node*;
-		auto _not() -> Node*;
-		auto _return() -> Node*;
-		auto de_ref() -> Node*;
-		auto ptr_to() -> Node*;
-		auto call() -> Node*;
-		auto store() -> Node*;
-		auto write() -> Node*;
-
 	private:
 		auto advance(i8 n) -> void;
 		auto advance() -> void;
 
-		auto peek(i8 n) -> Token*;
-		auto peek() -> Token*;
+		auto at(i8 n) -> size;
+
+		auto kind(i8 n) -> Kind;
+		auto kind() -> Kind;
+		auto trivia() -> Trivia;
+
+		auto token(i8 n) -> Token;
+		auto token() -> Token;
 
 		auto check(i8 n, Kind kind) -> bool;
 		auto check(Kind kind) -> bool;
 
 		auto consume(Kind kind) -> Token*;
-
-		auto not_impl(std::string msg) -> void;
-		auto parse_error(std::string name) -> void;
+		auto skip(Kind kind) -> void;
+		auto take() -> Token*;
+
+		auto is_blank(Trivia kind) -> bool;
+		auto blank(Trivia kind) -> void;
+		auto blank_token() -> Token*;
+		auto space() -> void;
+		auto tab() -> void;
+
+		auto describe(Token token) -> std::string;
+		[[noreturn]] auto not_impl(std::string msg) -> void;
+		[[noreturn]] auto parse_error(std::string name) -> void;
 };
 
 }
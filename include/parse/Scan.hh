@@ -0,0 +1,48 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Defs.hh>
+
+#include <vector>
+
+namespace hive::ir {
+
+enum class ScanLevel : u8 {
+	SCALAR,
+	SSE2,
+	AVX2,
+};
+
+/**
+ * Byte run kernels used by the lexer. Every kernel returns a pointer to the
+ * first byte that ends the run, and always stops on the '\0' sentinel.
+ *
+ * The vector versions read up to 31 bytes past that byte, which is safe
+ * because SourceBuffer pads every buffer with zeros.
+ */
+struct ScanKernels {
+	ScanLevel level;
+	const char* name;
+
+	// first byte that is not [A-Za-z0-9_]
+	auto (*ident_end)(const char* ptr) -> const char*;
+	// first '"' or '\0'
+	auto (*quote_end)(const char* ptr) -> const char*;
+	// first byte that is not a space or a tab
+	auto (*blank_end)(const char* ptr) -> const char*;
+	// appends the offset after every '\n' in the first length bytes, the only kernel that is not sentinel bound
+	auto (*line_starts)(const char* ptr, size length, std::vector<u32>& lines) -> void;
+};
+
+// The best kernels this cpu supports, picked once on first use
+auto scan_kernels() -> const ScanKernels&;
+
+// A specific level, falls back to the best supported one below it
+auto scan_kernels(ScanLevel level) -> const ScanKernels&;
+
+}
@@ -0,0 +1,60 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Defs.hh>
+
+#include <string>
+
+namespace hive::ir {
+
+/**
+ * Read only view of a source file.
+ *
+ * Regular files are mapped instead of read so large inputs are paged in on
+ * demand rather than copied to the heap. Pipes and stdin ("-") are read in
+ * chunks into a growing buffer. Either way at least PADDING zero bytes
+ * follow the last byte, so the lexer can look ahead past the end without
+ * range checks.
+ *
+ * Tokens and line tables hold u32 offsets, so a source longer than
+ * MAX_LENGTH fails to load.
+ */
+class SourceBuffer {
+	public:
+		static constexpr size PADDING    = 64;
+		static constexpr size READ_CHUNK = 64 * 1024;
+		static constexpr size MAX_LENGTH = ((size)1 << 32) - 1;
+
+		SourceBuffer() = default;
+		~SourceBuffer();
+
+		SourceBuffer(const SourceBuffer&) = delete;
+		auto operator=(const SourceBuffer&) -> SourceBuffer& = delete;
+
+		auto load(const char* path) -> bool;
+
+		auto data() const -> const char*;
+		auto length() const -> size;
+		auto is_mapped() const -> bool;
+
+		std::string error;
+
+	private:
+		char* bytes   = nullptr;
+		size len      = 0;
+		size capacity = 0;
+		bool mapped   = false;
+
+	private:
+		auto map_file(int fd, size file_size, const char* path) -> bool;
+		auto read_stream(int fd, const char* path) -> bool;
+		auto too_long(const char* path) -> std::string;
+		auto unload() -> void;
+};
+
+}
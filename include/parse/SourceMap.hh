@@ -0,0 +1,62 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Defs.hh>
+#include <parse/SourceBuffer.hh>
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hive::ir {
+
+using FileId = u32;
+
+struct SourceFile {
+	std::string path;
+	SourceBuffer buffer;
+
+	// offset of the first char of every line, built the first time a diagnostic asks for a line
+	std::vector<u32> lines;
+	std::once_flag lines_once;
+};
+
+struct Location {
+	u32 line;   // 1 based
+	u32 column; // 1 based
+};
+
+/**
+ * Registry of every file that took part in a compilation. Positions only
+ * carry the FileId and resolve the path through here when printing.
+ *
+ * The map also owns each file's buffer, tokens point into it so it has to
+ * live as long as the compilation does.
+ */
+class SourceMap {
+	public:
+		auto add(std::string_view path) -> FileId;
+		auto path(FileId file) const -> std::string_view;
+		auto file(FileId file) -> SourceFile&;
+
+		// Unloads every file, any FileId handed out before is invalid after
+		auto clear() -> void;
+
+		// Line and column of a byte offset, safe to call from several threads
+		auto location(FileId file, u32 offset) -> Location;
+
+	private:
+		auto line_table(SourceFile& source) -> const std::vector<u32>&;
+
+	private:
+		std::deque<SourceFile> files;
+};
+
+}
@@ -0,0 +1,70 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Cli.hh>
+
+#include <atomic>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace hive::ir {
+
+/**
+ * Compile server on a Unix domain socket, so a build that runs hir many
+ * times pays process start and cold memory once instead of per file.
+ *
+ * A request is a whole hir command line. The client sends
+ *
+ *   u32 length, then length bytes of NUL terminated strings: cwd, args...
+ *
+ * and gets back what the CLI would have printed
+ *
+ *   i32 exit code, u32 length, then length bytes of output
+ *
+ * Every worker thread blocks in accept() on the shared socket and keeps one
+ * Compiler for all of its requests, reset between them so the arenas and
+ * tables stay warm. Requests are parsed on their worker with -j 1 unless
+ * they ask for more, the workers already use the cores.
+ */
+class Server {
+	public:
+		static constexpr size MAX_REQUEST_BYTES = 64 * 1024;
+
+		// A client that stops sending or reading for this long is dropped, so it can not hold a worker
+		static constexpr int IO_TIMEOUT_SECONDS = 5;
+
+		// 0 workers means one per hardware thread
+		Server(std::string path, size workers = 0);
+		~Server();
+
+		Server(const Server&) = delete;
+		auto operator=(const Server&) -> Server& = delete;
+
+		// Serves until stop(), only returns a Diagnostic when the socket can not be set up
+		auto run() -> std::optional<Diagnostic>;
+
+		// Safe to call from a signal handler, run() returns once the workers finish their requests
+		auto stop() -> void;
+
+	private:
+		std::string path;
+		size workers;
+		std::atomic<int> listener = -1; // only set once the socket at path is ours
+		std::atomic<bool> stopping = false;
+
+	private:
+		auto listen() -> void;
+		auto work() -> void;
+		auto serve(Compiler& compiler, int connection) -> void;
+};
+
+// Client side, sends args (as run_cli takes them) to the server at path and copies back its output
+auto forward(const char* path, std::span<const char* const> args, std::string& out) -> int;
+
+}
@@ -6,33 +6,52 @@
 #pragma once
 
 #include <token/TokenKind.hh>
+#include <parse/SourceMap.hh>
+#include <util/Interner.hh>
+
+#include <string_view>
+#include <system_error>
 
 namespace hive::ir {
 
+/**
+ * Where a token sits in its file. Line and column are not kept, they are
+ * looked up in the SourceMap when a diagnostic prints the position.
+ */
 struct Pos {
-	std::string path;
-	size offset_start;
-	size line;
-	size column;
-	size offset_end;;
-	size len;
+	FileId file = 0;
+	u32 offset  = 0;
+	u32 len     = 0;
+
+	Pos() = default;
+	Pos(FileId file, size offset, size len);
 
-	Pos(std::string path, size offset_start, size line, size column, size offset_end);
+	auto to_string(SourceMap& sources) -> std::string;
+};
 
-	auto to_string() -> std::string;
+// Decoded value of a number or register token, FLOAT_LITERAL uses real and the rest integer
+union TokenValue {
+	u64 integer;
+	double real;
 };
 
+// Decodes the text of a number or register token, errc::result_out_of_range if it does not fit
+auto decode_number(TokenKind kind, std::string_view text, TokenValue& value) -> std::errc;
+
 class Token {
 	using Kind = TokenKind;
 
 	public:
-		Token(std::string name, Kind kind, Pos pos);
-		Token(std::string name, Pos pos);
+		Token() = default;
+		Token(std::string_view name, Kind kind, Pos pos);
+		Token(std::string_view name, Pos pos);
 		Token(Kind kind, Pos pos);
 
 	public:
-		std::string name;
-		Kind kind;
+		std::string_view name; // view into the source buffer, or the kind name
+		Kind kind = Kind::_EOF;
+		Symbol symbol = NO_SYMBOL; // set for identifiers
+		TokenValue value = {0};    // set for numbers and registers
 		Pos pos;
 
 		auto is_literal() -> bool;
@@ -44,8 +63,8 @@ class Token {
 		auto is_register() -> bool;
 		auto is_compare() -> bool;
 		auto is_jump() -> bool;
-		auto to_string() -> std::string;
-		auto short_to_string() -> std::string;
+		auto to_string(SourceMap& sources) -> std::string;
+		auto short_to_string(SourceMap& sources) -> std::string;
 };
 
 }
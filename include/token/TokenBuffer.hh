@@ -0,0 +1,64 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <Defs.hh>
+#include <token/TokenKind.hh>
+
+namespace hive::ir {
+
+// Blank run that came before a token when the lexer folds whitespace away
+enum class Trivia : u8 {
+	NONE,
+	SPACE, // the run started with a space
+	TAB,   // the run started with a tab
+};
+
+/**
+ * Structure of arrays token storage, a token is a kind, the blank in front
+ * of it with its width and an 8 byte offset/length pair into the source. Numbers and
+ * registers also have their decoded value. Line, column and text are worked
+ * out from the offset only when Lex::token() turns a slot into a full Token.
+ *
+ * Slots are indexed by the absolute token number and wrap around CAPACITY,
+ * the lexer appends at the back while the parser reads from the front.
+ */
+class TokenBuffer {
+	public:
+		// Note: Must be a power of two
+		static constexpr size CAPACITY = 1024;
+		static constexpr size MASK     = CAPACITY - 1;
+
+		TokenKind kinds[CAPACITY];
+		Trivia trivia[CAPACITY];
+		u32 widths[CAPACITY]; // blanks in that run, the parser only accepts a run of one
+		u32 offsets[CAPACITY];
+		u32 lengths[CAPACITY];
+		u64 values[CAPACITY]; // TokenValue bits, only meaningful for numbers and registers
+
+		size count = 0; // tokens appended so far
+
+		auto push(TokenKind kind, Trivia blank, u32 width, u32 offset, u32 length, u64 value = 0) -> void {
+			size slot = count++ & MASK;
+			kinds[slot]   = kind;
+			trivia[slot]  = blank;
+			widths[slot]  = width;
+			offsets[slot] = offset;
+			lengths[slot] = length;
+			values[slot]  = value;
+		}
+
+		auto kind(size n) const -> TokenKind { return kinds[n & MASK]; }
+		auto blank(size n) const -> Trivia { return trivia[n & MASK]; }
+		auto width(size n) const -> u32 { return widths[n & MASK]; }
+		auto offset(size n) const -> u32 { return offsets[n & MASK]; }
+		auto length(size n) const -> u32 { return lengths[n & MASK]; }
+		auto value(size n) const -> u64 { return values[n & MASK]; }
+
+		auto clear_blank(size n) -> void { trivia[n & MASK] = Trivia::NONE; }
+};
+
+}
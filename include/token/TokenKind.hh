@@ -12,6 +12,7 @@
 //             Or do we just wait till we to a language rewrite in minerva?
 #include <map>
 #include <string>
+#include <string_view>
 
 namespace hive::ir {
 
@@ -102,13 +103,38 @@ namespace hive::ir {
 	Tok(I64, "i64") \
 	Tok(TYPE_END, "") \
 
-enum class TokenKind {
+// Tokens that are a single char, the lexer builds its char class table from this
+#define TOKEN_PUNCT_LIST \
+	Punct(',', COMMA) \
+	Punct(':', COLON) \
+	Punct('.', DOT) \
+	Punct('#', POUND) \
+	Punct('|', PIPE) \
+	Punct('(', OPEN_PARAN) \
+	Punct(')', CLOSE_PARAN) \
+	Punct('{', OPEN_BRACE) \
+	Punct('}', CLOSE_BRACE) \
+	Punct('[', OPEN_BRACKET) \
+	Punct(']', CLOSE_BRACKET) \
+
+enum class TokenKind : u8 {
 	#define Tok(kind, name) kind,
 		TOKEN_TYPES_LIST
 	#undef Tok
 };
 
-auto name_from_kind(TokenKind kind) -> std::string;
-auto kind_from_name(std::string name) -> TokenKind;
+auto name_from_kind(TokenKind kind) -> std::string_view;
+
+// Keyword lookup, anything that is not a keyword is an IDENT_LITERAL
+auto kind_from_name(std::string_view name) -> TokenKind;
+
+// Range checks over the _START/_END markers so they work without a Token
+constexpr auto is_literal(TokenKind kind) -> bool { return TokenKind::LITERAL_START < kind && kind < TokenKind::LITERAL_END; }
+constexpr auto is_type(TokenKind kind) -> bool { return TokenKind::TYPE_START < kind && kind < TokenKind::TYPE_END; }
+constexpr auto is_instruction(TokenKind kind) -> bool { return TokenKind::INSTRUCTION_START < kind && kind < TokenKind::INSTRUCTION_END; }
+constexpr auto is_bi_instruction(TokenKind kind) -> bool { return TokenKind::BI_INSTRUCTION_START < kind && kind < TokenKind::BI_INSTRUCTION_END; }
+constexpr auto is_register(TokenKind kind) -> bool { return TokenKind::REISTER_START < kind && kind < TokenKind::REISTER_END; }
+constexpr auto is_compare(TokenKind kind) -> bool { return TokenKind::COMPARE_START < kind && kind < TokenKind::COMPARE_END; }
+constexpr auto is_jump(TokenKind kind) -> bool { return TokenKind::JUMP_START < kind && kind < TokenKind::JUMP_END; }
 
 }
@@ -0,0 +1,89 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Defs.hh>
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace hive::ir {
+
+struct ArenaStats {
+	size bytes_used     = 0; // bytes handed out by alloc
+	size bytes_reserved = 0; // bytes requested from malloc
+	size allocations    = 0; // number of alloc calls
+	size chunks         = 0; // number of malloc calls
+};
+
+/**
+ * Bump allocator scoped to a compilation. Memory is taken from the system in
+ * chunks and only given back all at once by release() or the destructor.
+ *
+ * Objects with a non trivial destructor are recorded when created through
+ * make() and destroyed in reverse order on release.
+ */
+class Arena {
+	public:
+		static constexpr size DEFAULT_CHUNK_SIZE = 64 * 1024;
+		static constexpr size MAX_SPARE_CHUNKS   = 64;
+
+		explicit Arena(size chunk_size = DEFAULT_CHUNK_SIZE);
+		~Arena();
+
+		Arena(const Arena&) = delete;
+		auto operator=(const Arena&) -> Arena& = delete;
+
+		auto alloc(size bytes, size align) -> void*;
+
+		template <typename T, typename... Args>
+		auto make(Args&&... args) -> T* {
+			auto obj = new (alloc(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+			if constexpr (!std::is_trivially_destructible_v<T>) {
+				own(obj, [](void* ptr) { static_cast<T*>(ptr)->~T(); });
+			}
+			return obj;
+		}
+
+		// Takes over every chunk and pending destructor of other, leaving it empty
+		auto adopt(Arena& other) -> void;
+
+		auto release() -> void;
+
+		// Like release() but keeps up to MAX_SPARE_CHUNKS chunks around for the next allocations
+		auto reset() -> void;
+		auto stats() const -> const ArenaStats&;
+
+	private:
+		struct Chunk {
+			Chunk* next;
+			size capacity;
+		};
+
+		struct Cleanup {
+			Cleanup* next;
+			void* object;
+			void (*destroy)(void*);
+		};
+
+		Chunk* head       = nullptr;
+		Chunk* spare      = nullptr; // emptied by reset(), all chunk_size big
+		size spare_count  = 0;
+		Cleanup* cleanups = nullptr;
+		char* cursor      = nullptr;
+		char* limit       = nullptr;
+		size chunk_size;
+		ArenaStats counters;
+
+	private:
+		auto grow(size bytes, size align) -> void;
+		auto own(void* object, void (*destroy)(void*)) -> void;
+};
+
+}
@@ -0,0 +1,25 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Defs.hh>
+
+#include <string_view>
+
+namespace hive::ir {
+
+/**
+ * XXH64, same output as the reference xxHash. Used to key cached outputs by
+ * their inputs, fast enough that hashing a source costs less than reading it.
+ */
+auto xxh64(const void* data, size length, u64 seed = 0) -> u64;
+
+inline auto xxh64(std::string_view bytes, u64 seed = 0) -> u64 {
+	return xxh64(bytes.data(), bytes.size(), seed);
+}
+
+}
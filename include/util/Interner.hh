@@ -0,0 +1,51 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Defs.hh>
+#include <util/Arena.hh>
+
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace hive::ir {
+
+using Symbol = u32;
+
+constexpr Symbol NO_SYMBOL = 0;
+
+/**
+ * Maps each distinct string to a small integer so repeated identifiers
+ * compare with a single integer compare. Interned bytes are copied into
+ * storage owned by the interner, so symbols outlive the source buffer.
+ *
+ * Safe to share between threads, ParallelParse interns from every worker.
+ */
+class Interner {
+	public:
+		Interner();
+
+		Interner(const Interner&) = delete;
+		auto operator=(const Interner&) -> Interner& = delete;
+
+		auto intern(std::string_view str) -> Symbol;
+		auto lookup(Symbol symbol) const -> std::string_view;
+		auto count() const -> size;
+
+		// Forgets every symbol, the storage and table stay allocated for reuse
+		auto clear() -> void;
+
+	private:
+		mutable std::mutex lock;
+		Arena storage;
+		std::vector<std::string_view> strings;
+		std::unordered_map<std::string_view, Symbol> symbols;
+};
+
+}
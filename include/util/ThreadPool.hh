@@ -0,0 +1,72 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <Defs.hh>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hive::ir {
+
+/**
+ * Work stealing pool. Every worker has its own queue, jobs submitted from a
+ * worker go on that worker's queue and it takes the newest first, jobs from
+ * outside are dealt round robin. A worker with nothing left steals the
+ * oldest job of another, so one long job does not leave the jobs queued
+ * behind it waiting while other threads idle.
+ */
+class ThreadPool {
+	public:
+		using Job = std::function<void()>;
+
+		// 0 threads means one per hardware thread
+		explicit ThreadPool(size threads = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+		auto submit(Job job) -> void;
+
+		// Rethrows the first exception a job let out since the last wait(), the rest are dropped
+		auto wait() -> void;
+		auto thread_count() const -> size;
+
+		static auto hardware_threads() -> size;
+
+	private:
+		struct Queue {
+			std::mutex lock;
+			std::deque<Job> jobs;
+		};
+
+		std::vector<std::thread> workers;
+		std::vector<std::unique_ptr<Queue>> queues;
+		std::atomic<size> queued  = 0; // sitting in a queue
+		std::atomic<size> pending = 0; // submitted and not finished yet
+		std::atomic<size> next    = 0; // queue for the next outside submit
+
+		std::mutex lock; // only for sleeping and waking
+		std::condition_variable has_job;
+		std::condition_variable is_idle;
+		bool stopping = false;
+		std::exception_ptr error; // under lock
+
+	private:
+		auto work(size index) -> void;
+		auto take(size index, Job& job) -> bool;
+};
+
+}
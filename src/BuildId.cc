@@ -0,0 +1,18 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <BuildId.hh>
+
+// Generated on every build by cmake/BuildId.cmake
+#include <HirBuildId.hh>
+
+namespace hive::ir {
+
+auto build_id() -> std::string_view {
+	return HIR_BUILD_ID;
+}
+
+}
@@ -0,0 +1,341 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <Cli.hh>
+#include <cache/Cache.hh>
+#include <binary/BinaryReader.hh>
+#include <parse/SourceBuffer.hh>
+#include <util/ThreadPool.hh>
+
+#include <fmt/format.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <set>
+
+namespace hive::ir {
+
+struct CliArgs {
+	std::vector<std::string> inputs;
+	std::vector<std::pair<EmitKind, std::string>> emits; // in command line order
+	size threads;
+	std::string cache_dir;
+	size cache_size = Cache::DEFAULT_MAX_BYTES;
+	std::string state; // --incremental
+};
+
+// Output of one input, kept until every input before it is printed
+struct ModuleResult {
+	int code = 0;
+	std::string out;
+};
+
+static constexpr size MAX_RESPONSE_DEPTH = 8;
+
+static auto resolve(const CliEnv& env, std::string_view path) -> std::string {
+	if (env.cwd.empty() || path.starts_with('/') || path == "-") {
+		return std::string(path);
+	}
+	return fmt::format("{}/{}", env.cwd, path);
+}
+
+static auto file_name(std::string_view path) -> std::string_view {
+	auto slash = path.rfind('/');
+	return slash == std::string_view::npos ? path : path.substr(slash + 1);
+}
+
+// Appends the words of an @file, split on whitespace, expanding any @file inside it
+static auto expand(const CliEnv& env, std::string_view arg, std::vector<std::string>& words, size depth) -> std::optional<std::string> {
+	if (!arg.starts_with('@')) {
+		words.emplace_back(arg);
+		return std::nullopt;
+	}
+
+	if (depth == MAX_RESPONSE_DEPTH) {
+		return fmt::format("Response files nest deeper than {} at {}", MAX_RESPONSE_DEPTH, arg);
+	}
+
+	auto path = resolve(env, arg.substr(1));
+	std::FILE* file = std::fopen(path.c_str(), "rb");
+
+	if (!file) {
+		return fmt::format("Unable to read response file {}", path);
+	}
+
+	std::string text;
+	char chunk[4096];
+
+	for (size got; (got = std::fread(chunk, 1, sizeof(chunk), file)) > 0;) {
+		text.append(chunk, got);
+	}
+	std::fclose(file);
+
+	size at = 0;
+	while (at < text.size()) {
+		at = text.find_first_not_of(" \t\r\n", at);
+		if (at == std::string::npos) break;
+
+		size end = text.find_first_of(" \t\r\n", at);
+		if (end == std::string::npos) end = text.size();
+
+		if (auto error = expand(env, std::string_view(text).substr(at, end - at), words, depth + 1)) {
+			return error;
+		}
+		at = end;
+	}
+	return std::nullopt;
+}
+
+static auto parse_args(const CliEnv& env, std::span<const char* const> args, CliArgs& cli) -> std::optional<std::string> {
+	std::vector<std::string> words;
+
+	For(args) {
+		if (auto error = expand(env, it, words, 0)) return error;
+	}
+
+	for (size i = 0; i < words.size(); i++) {
+		auto& word = words[i];
+
+		if (!word.starts_with('-') || word == "-") {
+			cli.inputs.push_back(word);
+			continue;
+		}
+
+		if (word != "-j" && word != "--emit-text" && word != "--emit-binary" && word != "--cache" && word != "--cache-size" && word != "--incremental") {
+			return fmt::format("Unknown option {}", word);
+		}
+		if (i + 1 == words.size()) {
+			return fmt::format("Missing value for {}", word);
+		}
+
+		auto& value = words[++i];
+
+		if (word == "-j") {
+			cli.threads = std::strtoul(value.c_str(), nullptr, 10);
+		} else if (word == "--cache") {
+			cli.cache_dir = value;
+		} else if (word == "--cache-size") {
+			cli.cache_size = std::strtoull(value.c_str(), nullptr, 10);
+		} else if (word == "--incremental") {
+			cli.state = value;
+		} else {
+			cli.emits.push_back({word == "--emit-text" ? EmitKind::TEXT : EmitKind::BINARY, value});
+		}
+	}
+
+	if (cli.inputs.empty()) {
+		return std::string(CLI_USAGE);
+	}
+	return std::nullopt;
+}
+
+static auto write_file(const std::string& target, const std::string& bytes) -> bool {
+	std::FILE* file = std::fopen(target.c_str(), "wb");
+	if (!file) return false;
+
+	bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+	return std::fclose(file) == 0 && ok;
+}
+
+static auto emit(Compiler& compiler, ProgNode* files, const CliArgs& cli, const std::vector<std::string>& targets, Cache* cache, const std::vector<CacheKey>& keys, std::string& out) -> int {
+	std::string bytes;
+
+	for (size i = 0; i < cli.emits.size(); i++) {
+		if (auto error = compiler.emit(files, cli.emits[i].first, bytes)) {
+			out.append(error->message).append("\n");
+			return error->code;
+		}
+
+		if (!write_file(targets[i], bytes)) {
+			out.append(fmt::format("Unable to write file {}\n", targets[i]));
+			return ErrorCode::IO_ERROR;
+		}
+
+		if (cache && i < keys.size()) cache->store(keys[i], bytes);
+	}
+	return 0;
+}
+
+// True when every output came out of the cache, keys gets the key of each emit either way
+static auto from_cache(Cache& cache, const CliArgs& cli, const std::string& path, const std::vector<std::string>& targets, std::vector<CacheKey>& keys) -> bool {
+	SourceBuffer source;
+
+	if (path == "-" || !source.load(path.c_str())) return false;
+
+	std::string_view bytes(source.data(), source.length());
+	bool hit = true;
+
+	for (size i = 0; i < cli.emits.size(); i++) {
+		keys.push_back(Cache::key(bytes, cli.emits[i].first));
+		hit = hit && cache.fetch(keys[i], targets[i].c_str());
+	}
+	return hit;
+}
+
+// Every output is text and the input is a text file, so the LABEL groups can be reused one by one
+static auto can_reuse_labels(const CliArgs& cli, const std::string& path) -> bool {
+	For(cli.emits) {
+		if (it.first != EmitKind::TEXT) return false;
+	}
+	return !cli.emits.empty() && path != "-" && !BinaryReader::is_binary(path.c_str());
+}
+
+static auto compile_incremental(Compiler& compiler, const std::string& path, const std::string& state, const std::vector<std::string>& targets, Cache* cache, const std::vector<CacheKey>& keys, std::string& out) -> int {
+	std::string text;
+
+	compiler.reset(CompileOptions{1});
+
+	if (auto error = compiler.emit_incremental(path.c_str(), state.c_str(), text)) {
+		out.append(error->message).append("\n");
+		return error->code;
+	}
+
+	for (size i = 0; i < targets.size(); i++) {
+		if (!write_file(targets[i], text)) {
+			out.append(fmt::format("Unable to write file {}\n", targets[i]));
+			return ErrorCode::IO_ERROR;
+		}
+		if (cache && i < keys.size()) cache->store(keys[i], text);
+	}
+	return 0;
+}
+
+static auto compile_one(Compiler& compiler, const CliEnv& env, const CliArgs& cli, size threads, Cache* cache, std::string_view input, const std::string& state, const std::vector<std::string>& targets, std::string& out) -> int {
+	auto path = resolve(env, input);
+	std::vector<CacheKey> keys;
+
+	if (cache && !cli.emits.empty() && from_cache(*cache, cli, path, targets, keys)) {
+		return 0;
+	}
+
+	if (!state.empty() && can_reuse_labels(cli, path)) {
+		return compile_incremental(compiler, path, state, targets, cache, keys, out);
+	}
+
+	compiler.reset(CompileOptions{threads});
+	auto result = compiler.parse(path.c_str());
+
+	if (!result.ok()) {
+		out.append(result.error->message).append("\n");
+		return result.error->code;
+	}
+
+	return emit(compiler, result.program, cli, targets, cache, keys, out);
+}
+
+/**
+ * With several inputs every --emit-* and --incremental names a directory
+ * and each input writes <dir>/<file name>, .hirb for binary and .state for
+ * its incremental state. Inputs are compiled whole on
+ * the pool, one Compiler each, and their output is printed in input order
+ * once all are done so a run prints the same thing whatever the timing.
+ */
+static auto compile_many(const CliEnv& env, const CliArgs& cli, Cache* cache, std::string& out) -> int {
+	std::vector<std::vector<std::string>> targets(cli.inputs.size());
+	std::vector<std::string> states(cli.inputs.size());
+	std::set<std::string> taken;
+
+	for (size i = 0; i < cli.inputs.size(); i++) {
+		auto name = file_name(cli.inputs[i]);
+		if (name.ends_with(".hir")) name.remove_suffix(4);
+
+		if (!cli.state.empty()) {
+			states[i] = resolve(env, fmt::format("{}/{}.state", cli.state, name));
+
+			if (!taken.insert(states[i]).second) {
+				out.append(fmt::format("More than one input would write {}\n", states[i]));
+				return -1;
+			}
+		}
+
+		For(cli.emits) {
+			auto target = resolve(env, fmt::format("{}/{}{}", it.second, name, it.first == EmitKind::TEXT ? ".hir" : ".hirb"));
+
+			if (!taken.insert(target).second) {
+				out.append(fmt::format("More than one input would write {}\n", target));
+				return -1;
+			}
+			targets[i].push_back(std::move(target));
+		}
+	}
+
+	std::vector<ModuleResult> results(cli.inputs.size());
+	{
+		ThreadPool pool(cli.threads);
+
+		for (size i = 0; i < cli.inputs.size(); i++) {
+			pool.submit([&, i] {
+				// one input running out of memory or hitting a bug must not cost the others their output
+				try {
+					Compiler compiler;
+					results[i].code = compile_one(compiler, env, cli, 1, cache, cli.inputs[i], states[i], targets[i], results[i].out);
+				} catch (const std::exception& error) {
+					results[i].code = ErrorCode::INTERNAL_ERROR;
+					results[i].out.append(fmt::format("Internal error compiling {}: {}\n", cli.inputs[i], error.what()));
+				}
+			});
+		}
+		pool.wait();
+	}
+
+	int code = 0;
+
+	For(results) {
+		out.append(it.out);
+		if (code == 0) code = it.code;
+	}
+	return code;
+}
+
+auto run_cli(Compiler& compiler, std::span<const char* const> args, const CliEnv& env, std::string& out) -> int {
+	CliArgs cli;
+	cli.threads = env.threads;
+
+	if (auto error = parse_args(env, args, cli)) {
+		out.append(*error).append("\n");
+		return -1;
+	}
+
+	// stdin would be the server's own, not the client's
+	if (!env.cwd.empty()) {
+		For(cli.inputs) {
+			if (it == "-") {
+				out.append("Reading from stdin is not supported through the compile server\n");
+				return -1;
+			}
+		}
+	}
+
+	std::unique_ptr<Cache> cache;
+
+	if (!cli.cache_dir.empty()) {
+		cache = std::make_unique<Cache>(resolve(env, cli.cache_dir), cli.cache_size);
+
+		if (auto error = cache->open()) {
+			out.append(error->message).append("\n");
+			return error->code;
+		}
+	}
+
+	int code;
+
+	if (cli.inputs.size() > 1) {
+		code = compile_many(env, cli, cache.get(), out);
+	} else {
+		std::vector<std::string> targets;
+		For(cli.emits) targets.push_back(resolve(env, it.second));
+
+		auto state = cli.state.empty() ? std::string() : resolve(env, cli.state);
+		code = compile_one(compiler, env, cli, cli.threads, cache.get(), cli.inputs[0], state, targets, out);
+	}
+
+	if (cache) cache->trim();
+	return code;
+}
+
+}
@@ -0,0 +1,119 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <Compiler.hh>
+#include <parse/Parse.hh>
+#include <parse/ParallelParse.hh>
+#include <binary/BinaryReader.hh>
+#include <binary/BinaryWriter.hh>
+#include <node/Printer.hh>
+#include <parse/ModuleState.hh>
+
+#include <fmt/core.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace hive::ir {
+
+Compiler::Compiler(CompileOptions options) : options(options) {}
+
+auto Compiler::reset(CompileOptions options) -> void {
+	this->options = options;
+	ctx.reset();
+}
+
+auto Compiler::parse(const char* target) -> CompileResult {
+	CompileResult result;
+
+	try {
+		if (BinaryReader::is_binary(target)) {
+			BinaryReader reader(target, &ctx);
+			result.program = reader.program();
+		} else if (options.threads == 1 || std::strcmp(target, "-") == 0) {
+			Lex lex(target, LexMode::TRIVIA_FREE, &ctx);
+			result.program = Parse(&lex).construct();
+		} else {
+			ParallelParse parse(target, &ctx, options.threads);
+			result.program = parse.construct();
+		}
+	} catch (const CompileError& error) {
+		result.error = error.diagnostic;
+	}
+	return result;
+}
+
+auto Compiler::emit_incremental(const char* target, const char* state, std::string& out) -> std::optional<Diagnostic> {
+	ModuleState previous;
+	ModuleState next;
+
+	previous.load(state);
+
+	try {
+		ParallelParse parse(target, &ctx, 1);
+		auto source = parse.source();
+
+		auto segments = parse.segments();
+
+		// Note: The segment at 0 is always parsed, that is where the lexer checks
+		//       the file starts with its version directive
+		if (segments.empty()) segments.push_back({0, 0});
+
+		For(segments) {
+			auto hash = ModuleState::hash(source.substr(it.first, it.second - it.first));
+			const Segment* kept = nullptr;
+
+			if (it.first != 0) {
+				kept = next.find(hash);
+				if (!kept) kept = previous.find(hash);
+			}
+
+			if (kept) {
+				next.reuse(*kept);
+			} else {
+				next.add(hash, Printer().print(parse.parse_segment(it)));
+			}
+		}
+	} catch (const CompileError& error) {
+		return error.diagnostic;
+	}
+
+	out.clear();
+	For(next.segments) out.append(it.text);
+
+	if (!next.save(state)) {
+		return Diagnostic{ErrorCode::IO_ERROR, fmt::format("Unable to write file {}", state)};
+	}
+	return std::nullopt;
+}
+
+auto Compiler::emit(ProgNode* program, EmitKind kind, std::string& out) -> std::optional<Diagnostic> {
+	try {
+		out = kind == EmitKind::TEXT ? Printer().print(program) : BinaryWriter(program).encode();
+	} catch (const CompileError& error) {
+		return error.diagnostic;
+	}
+	return std::nullopt;
+}
+
+auto Compiler::emit(ProgNode* program, EmitKind kind, const char* target) -> std::optional<Diagnostic> {
+	std::string out;
+
+	if (auto error = emit(program, kind, out)) {
+		return error;
+	}
+
+	std::FILE* file = std::fopen(target, kind == EmitKind::TEXT ? "w" : "wb");
+
+	if (!file) {
+		return Diagnostic{ErrorCode::IO_ERROR, fmt::format("Unable to write file {}", target)};
+	}
+	std::fwrite(out.data(), 1, out.size(), file);
+	std::fclose(file);
+	return std::nullopt;
+}
+
+}
@@ -1,15 +1,59 @@
-#include <parse/Parse.hh>
+#include <Cli.hh>
+#include <server/Server.hh>
 
 #include <fmt/core.h>
 
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
 
 using namespace hive::ir;
 
+static Server* serving = nullptr;
+
+// SIGINT/SIGTERM end --serve normally so the Server removes its socket on the way out
+static auto stop_serving(int) -> void {
+	if (serving) serving->stop();
+}
+
 auto main(int argc, char** argv) -> int {
-	auto lex = new Lex(argv[1], LexMode::TEXT);
-	Parse parse(lex);
+	if (argc < 2) {
+		fmt::println("{}", CLI_USAGE);
+		return -1;
+	}
+
+	std::string out;
+
+	if (std::strcmp(argv[1], "--serve") == 0 && argc >= 3) {
+		size workers = argc >= 5 && std::strcmp(argv[3], "-j") == 0 ? std::strtoul(argv[4], nullptr, 10) : 0;
+
+		Server server(argv[2], workers);
+
+		serving = &server;
+		std::signal(SIGINT, stop_serving);
+		std::signal(SIGTERM, stop_serving);
+
+		auto error = server.run();
+		serving = nullptr;
+
+		if (error) {
+			fmt::println("{}", error->message);
+			return error->code;
+		}
+		return 0;
+	}
+
+	if (std::strcmp(argv[1], "--connect") == 0 && argc >= 4) {
+		int code = forward(argv[2], std::span(argv + 3, argc - 3), out);
+		std::fwrite(out.data(), 1, out.size(), stdout);
+		return code;
+	}
 
-	auto files = parse.construct();
+	Compiler compiler;
+	int code = run_cli(compiler, std::span(argv + 1, argc - 1), CliEnv{}, out);
+	std::fwrite(out.data(), 1, out.size(), stdout);
 
 //	For(files->nodes) {
 //		if (it->kind == NodeKinds::DIRECTIVE_NODE) {
@@ -26,5 +70,5 @@ auto main(int argc, char** argv) -> int {
 //			}
 //	}
 
-	return 0;
+	return code;
 }
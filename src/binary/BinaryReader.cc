@@ -0,0 +1,315 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <binary/BinaryReader.hh>
+#include <node/Instruction.hh>
+
+#include <fmt/core.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace hive::ir {
+
+BinaryReader::BinaryReader(const char* target, Context* ctx) : ctx(ctx) {
+	file   = ctx->sources.add(target);
+	source = &ctx->sources.file(file).buffer;
+
+	if (!source->load(target)) {
+		binary_error(source->error);
+	}
+
+	if (source->length() < sizeof(BinaryHeader)) {
+		binary_error(fmt::format("{} is too small to be binary IR", target));
+	}
+
+	std::memcpy(&header, source->data(), sizeof(BinaryHeader));
+
+	if (std::memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+		binary_error(fmt::format("{} is not binary IR", target));
+	}
+
+	if (header.version != BINARY_VERSION) {
+		binary_error(fmt::format("{} is binary IR version {}, expected {}", target, header.version, BINARY_VERSION));
+	}
+
+	size strings_end = header.strings_offset + sizeof(u32) * ((size)header.string_count + 1);
+	size labels_end  = header.labels_offset + sizeof(BinaryLabel) * (size)header.label_count;
+
+	if (strings_end > source->length() || labels_end > source->length() || header.directives_offset > source->length()) {
+		binary_error(fmt::format("{} is truncated", target));
+	}
+
+	labels.resize(header.label_count, nullptr);
+}
+
+auto BinaryReader::is_binary(const char* target) -> bool {
+	char magic[sizeof(BINARY_MAGIC)] = {};
+	std::FILE* file = std::fopen(target, "rb");
+
+	if (!file) return false;
+
+	auto got = std::fread(magic, 1, sizeof(magic), file);
+	std::fclose(file);
+
+	return got == sizeof(magic) && std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0;
+}
+
+auto BinaryReader::label_count() -> size {
+	return header.label_count;
+}
+
+auto BinaryReader::label_name(size idx) -> std::string_view {
+	return string(label_entry(idx).name);
+}
+
+auto BinaryReader::label(size idx) -> LabelNode* {
+	if (labels.at(idx)) {
+		return labels[idx];
+	}
+
+	auto entry = label_entry(idx);
+	seek(entry.offset);
+
+	auto name  = literal();
+	size count = items(entry.count);
+
+	std::vector<Node*> instructions;
+	instructions.reserve(count);
+
+	for (size i = 0; i < count; i++) {
+		instructions.push_back(instruction());
+	}
+
+	labels[idx] = ctx->arena.make<LabelNode>(token(TokenKind::LABEL), name, std::move(instructions));
+	return labels[idx];
+}
+
+auto BinaryReader::program() -> ProgNode* {
+	std::vector<Node*> nodes;
+	std::vector<std::pair<size, Node*>> directives;
+	size next_label = 0;
+
+	// decode every directive before label() moves the cursor
+	seek(header.directives_offset);
+	for (size i = 0; i < header.directive_count; i++) {
+		size labels_before;
+		auto node = directive(labels_before);
+		directives.push_back({labels_before, node});
+	}
+
+	nodes.reserve(directives.size() + label_count());
+
+	For(directives) {
+		while (next_label < it.first && next_label < label_count()) {
+			nodes.push_back(label(next_label++));
+		}
+		nodes.push_back(it.second);
+	}
+
+	while (next_label < label_count()) {
+		nodes.push_back(label(next_label++));
+	}
+
+	return ctx->arena.make<ProgNode>(std::move(nodes), &ctx->arena);
+}
+
+auto BinaryReader::string(u32 id) -> std::string_view {
+	if (id >= header.string_count) {
+		binary_error(fmt::format("String id {} is out of range", id));
+	}
+
+	u32 bounds[2];
+	std::memcpy(bounds, source->data() + header.strings_offset + sizeof(u32) * id, sizeof(bounds));
+
+	size base = header.strings_offset + sizeof(u32) * ((size)header.string_count + 1);
+
+	if (bounds[0] > bounds[1] || base + bounds[1] > source->length()) {
+		binary_error(fmt::format("String {} is out of bounds", id));
+	}
+	return std::string_view(source->data() + base + bounds[0], bounds[1] - bounds[0]);
+}
+
+auto BinaryReader::label_entry(size idx) -> BinaryLabel {
+	BinaryLabel entry;
+	std::memcpy(&entry, source->data() + header.labels_offset + sizeof(BinaryLabel) * idx, sizeof(BinaryLabel));
+	return entry;
+}
+
+auto BinaryReader::seek(size offset) -> void {
+	if (offset > source->length()) {
+		binary_error(fmt::format("Offset {} is past the end of the file", offset));
+	}
+	cursor = (const u8*)source->data() + offset;
+	end    = (const u8*)source->data() + source->length();
+}
+
+auto BinaryReader::byte() -> u8 {
+	if (cursor >= end) {
+		binary_error("Unexpected end of binary IR");
+	}
+	return *cursor++;
+}
+
+auto BinaryReader::varint() -> u64 {
+	u64 value = 0;
+
+	for (u32 shift = 0; shift < 64; shift += 7) {
+		u8 part = byte();
+		value |= (u64)(part & 0x7F) << shift;
+		if (!(part & 0x80)) return value;
+	}
+
+	binary_error("Malformed varint");
+	return 0;
+}
+
+// Every item takes at least a byte, so a count past the end of the file is corrupt and must not reach reserve()
+auto BinaryReader::items(u64 count) -> size {
+	if (count > (u64)(end - cursor)) {
+		binary_error(fmt::format("Count {} runs past the end of the file", count));
+	}
+	return count;
+}
+
+auto BinaryReader::token(TokenKind kind, std::string_view name) -> Token* {
+	size offset = cursor ? cursor - (const u8*)source->data() : 0;
+	auto token  = ctx->arena.make<Token>(name, kind, Pos(file, offset, 0));
+
+	if (kind == TokenKind::IDENT_LITERAL) {
+		token->symbol = ctx->interner.intern(name);
+	} else if (is_literal(kind) && kind != TokenKind::STRING_LITERAL) {
+		// numbers are kept as written, decode them the way the lexer would
+		if (decode_number(kind, name, token->value) != std::errc()) {
+			binary_error(fmt::format("{} has a malformed number '{}'", ctx->sources.path(file), name));
+		}
+	}
+	return token;
+}
+
+auto BinaryReader::token(TokenKind kind) -> Token* {
+	return token(kind, name_from_kind(kind));
+}
+
+auto BinaryReader::directive(size& labels_before) -> Node* {
+	labels_before = varint();
+
+	auto name  = literal();
+	auto count = items(varint());
+
+	std::vector<Token*> tokens;
+	tokens.reserve(count);
+
+	for (size i = 0; i < count; i++) {
+		auto kind = byte();
+		if (kind >= (u8)TokenKind::TYPE_END) {
+			binary_error(fmt::format("Unknown token kind {}", kind));
+		}
+		tokens.push_back(token((TokenKind)kind, string(varint())));
+	}
+
+	return ctx->arena.make<DirectiveNode>(token(TokenKind::POUND, "#"), name, std::move(tokens));
+}
+
+auto BinaryReader::reg() -> Node* {
+	auto value = varint();
+	size id    = value >> 1;
+
+	if (value & 1) {
+		return ctx->registers.data_register(id);
+	}
+	return ctx->registers.virtual_register(id);
+}
+
+auto BinaryReader::literal() -> Node* {
+	auto kind = (Kind)byte();
+	auto text = string(varint());
+
+	switch (kind) {
+		case Kind::IDENT_LITERAL_NODE: return ctx->arena.make<IdentLiteralNode>(token(TokenKind::IDENT_LITERAL, text));
+		case Kind::HEX_LITERAL_NODE: return ctx->arena.make<HexLiteralNode>(token(TokenKind::HEX_LITERAL, text));
+		case Kind::DIGIT_LITERAL_NODE: return ctx->arena.make<DigitLiteralNode>(token(TokenKind::DIGIT_LITERAL, text));
+		case Kind::OCTAL_LITERAL_NODE: return ctx->arena.make<OctalLiteralNode>(token(TokenKind::OCTAL_LITERAL, text));
+		case Kind::BINARY_LITERAL_NODE: return ctx->arena.make<BinaryLiteralNode>(token(TokenKind::BINARY_LITERAL, text));
+		case Kind::FLOAT_LITERAL_NODE: return ctx->arena.make<FloatLiteralNode>(token(TokenKind::FLOAT_LITERAL, text));
+		case Kind::STRING_LITERAL_NODE: {
+			auto start = token(TokenKind::DOUBLE_QUOTE, "\"");
+			auto ident = token(TokenKind::STRING_LITERAL, text);
+			auto end   = token(TokenKind::DOUBLE_QUOTE, "\"");
+			return ctx->arena.make<StringLiteralNode>(start, ident, end);
+		}
+		default: binary_error(fmt::format("Unknown literal kind {}", (u8)kind));
+	}
+	return nullptr;
+}
+
+auto BinaryReader::type() -> Node* {
+	auto kind = (Kind)byte();
+
+	switch (kind) {
+		case Kind::I8_TYPE_NODE: return ctx->arena.make<TypeNode>(token(TokenKind::I8), kind);
+		case Kind::I16_TYPE_NODE: return ctx->arena.make<TypeNode>(token(TokenKind::I16), kind);
+		case Kind::I32_TYPE_NODE: return ctx->arena.make<TypeNode>(token(TokenKind::I32), kind);
+		case Kind::I64_TYPE_NODE: return ctx->arena.make<TypeNode>(token(TokenKind::I64), kind);
+		default: binary_error(fmt::format("Unknown type kind {}", (u8)kind));
+	}
+	return nullptr;
+}
+
+auto BinaryReader::instruction() -> Node* {
+	auto kind = (Kind)byte();
+
+	if (auto desc = find_instruction(kind)) {
+		InstructionOperands ops;
+		ops.ident = token(desc->token);
+
+		for (u8 i = 0; i < desc->count; i++) {
+			switch (desc->operands[i]) {
+				case Operand::REG:
+				case Operand::VREG: ops.nodes[i] = reg(); break;
+				case Operand::LITERAL: ops.nodes[i] = literal(); break;
+				case Operand::REGS: {
+					auto count = items(varint());
+					ops.list.reserve(count);
+					for (size n = 0; n < count; n++) {
+						ops.list.push_back(reg());
+					}
+					break;
+				}
+				default: binary_error(fmt::format("Operand {} of instruction kind {} can not be decoded", i, (u8)kind));
+			}
+		}
+		return desc->make(&ctx->arena, ops, kind);
+	}
+
+	switch (kind) {
+		case Kind::DATA_STATIC_NODE: {
+			auto data  = reg();
+			auto ident = token(TokenKind::STATIC);
+			auto lit   = literal();
+			return ctx->arena.make<DataStaticNode>(data, ident, lit);
+		}
+		case Kind::DATA_TYPE_NODE: {
+			auto data  = reg();
+			auto count = items(varint());
+
+			std::vector<Node*> types;
+			types.reserve(count);
+			for (size i = 0; i < count; i++) {
+				types.push_back(type());
+			}
+			return ctx->arena.make<DataTypeNode>(data, token(TokenKind::OPEN_BRACE, "{"), std::move(types), token(TokenKind::CLOSE_BRACE, "}"));
+		}
+		default: binary_error(fmt::format("Unknown instruction kind {}", (u8)kind));
+	}
+	return nullptr;
+}
+
+auto BinaryReader::binary_error(std::string msg) -> void {
+	compile_error(ErrorCode::BINARY_ERROR, fmt::format("Binary Error: {}", msg));
+}
+
+}
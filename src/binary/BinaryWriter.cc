@@ -0,0 +1,202 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <binary/BinaryWriter.hh>
+#include <node/Instruction.hh>
+#include <err/Diagnostic.hh>
+
+#include <fmt/core.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace hive::ir {
+
+template <typename T>
+static auto append(std::string& out, const T& value) -> void {
+	out.append((const char*)&value, sizeof(T));
+}
+
+BinaryWriter::BinaryWriter(ProgNode* program) : program(program) {}
+
+auto BinaryWriter::encode() -> std::string {
+	std::vector<BinaryLabel> labels;
+	std::vector<LabelNode*> label_nodes;
+	size directive_count = 0;
+
+	body.clear();
+	strings.clear();
+	string_ids.clear();
+
+	// directives first so every label body sits after them
+	For(program->nodes) {
+		if (it->kind == Kind::LABEL_NODE) {
+			label_nodes.push_back((LabelNode*)it);
+		} else if (it->kind == Kind::DIRECTIVE_NODE) {
+			directive((DirectiveNode*)it, label_nodes.size());
+			directive_count++;
+		}
+	}
+
+	For(label_nodes) {
+		u32 offset = body.size();
+		labels.push_back(BinaryLabel{literal(it->name), offset, (u32)it->instructions.size()});
+
+		for (auto inst : it->instructions) {
+			instruction(inst);
+		}
+	}
+
+	size strings_size = sizeof(u32) * (strings.size() + 1);
+	For(strings) strings_size += it.size();
+
+	BinaryHeader header;
+	std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+	header.version           = BINARY_VERSION;
+	header.flags             = 0;
+	header.string_count      = strings.size();
+	header.strings_offset    = sizeof(BinaryHeader);
+	header.label_count       = labels.size();
+	header.labels_offset     = header.strings_offset + strings_size;
+	header.directive_count   = directive_count;
+	header.directives_offset = header.labels_offset + sizeof(BinaryLabel) * labels.size();
+
+	std::string out;
+	out.reserve(header.directives_offset + body.size());
+	append(out, header);
+
+	u32 offset = 0;
+	For(strings) {
+		append(out, offset);
+		offset += it.size();
+	}
+	append(out, offset);
+	For(strings) out.append(it);
+
+	For(labels) {
+		it.offset += header.directives_offset;
+		append(out, it);
+	}
+
+	out.append(body);
+	return out;
+}
+
+auto BinaryWriter::write(std::string target) -> void {
+	auto bytes = encode();
+	std::FILE* file = std::fopen(target.c_str(), "wb");
+
+	if (!file) {
+		compile_error(ErrorCode::IO_ERROR, fmt::format("Unable to write file {}", target));
+	}
+	std::fwrite(bytes.data(), 1, bytes.size(), file);
+	std::fclose(file);
+}
+
+auto BinaryWriter::string(std::string_view str) -> u32 {
+	auto found = string_ids.find(str);
+	if (found != string_ids.end()) {
+		return found->second;
+	}
+
+	u32 id = strings.size();
+	strings.push_back(str);
+	string_ids.emplace(str, id);
+	return id;
+}
+
+auto BinaryWriter::byte(u8 value) -> void {
+	body.push_back((char)value);
+}
+
+auto BinaryWriter::varint(u64 value) -> void {
+	while (value >= 0x80) {
+		byte((u8)(value | 0x80));
+		value >>= 7;
+	}
+	byte((u8)value);
+}
+
+auto BinaryWriter::directive(DirectiveNode* directive, size labels_before) -> void {
+	varint(labels_before);
+	literal(directive->name);
+	varint(directive->tokens.size());
+
+	For(directive->tokens) {
+		byte((u8)it->kind);
+		varint(string(it->name));
+	}
+}
+
+auto BinaryWriter::reg(Node* node) -> void {
+	if (node->kind == Kind::DATA_REGISTER_NODE) {
+		varint(((DataRegisterNode*)node)->id << 1 | 1);
+	} else {
+		varint(((VirtualRegisterNode*)node)->id << 1);
+	}
+}
+
+auto BinaryWriter::literal(Node* node) -> u32 {
+	byte((u8)node->kind);
+
+	u32 id = 0;
+	switch (node->kind) {
+		case Kind::IDENT_LITERAL_NODE: id = string(((IdentLiteralNode*)node)->ident->name); break;
+		case Kind::STRING_LITERAL_NODE: id = string(((StringLiteralNode*)node)->ident->name); break;
+		case Kind::HEX_LITERAL_NODE: id = string(((HexLiteralNode*)node)->ident->name); break;
+		case Kind::DIGIT_LITERAL_NODE: id = string(((DigitLiteralNode*)node)->ident->name); break;
+		case Kind::OCTAL_LITERAL_NODE: id = string(((OctalLiteralNode*)node)->ident->name); break;
+		case Kind::BINARY_LITERAL_NODE: id = string(((BinaryLiteralNode*)node)->ident->name); break;
+		case Kind::FLOAT_LITERAL_NODE: id = string(((FloatLiteralNode*)node)->ident->name); break;
+		default: Panic(fmt::format("Can not encode literal {}", node->to_string()))
+	}
+
+	varint(id);
+	return id;
+}
+
+auto BinaryWriter::instruction(Node* node) -> void {
+	byte((u8)node->kind);
+
+	if (auto desc = find_instruction(node->kind)) {
+		InstructionOperands ops;
+		desc->operands_of(node, ops);
+
+		for (u8 i = 0; i < desc->count; i++) {
+			switch (desc->operands[i]) {
+				case Operand::REG:
+				case Operand::VREG: reg(ops.nodes[i]); break;
+				case Operand::LITERAL: literal(ops.nodes[i]); break;
+				case Operand::REGS: {
+					varint(ops.list.size());
+					For(ops.list) reg(it);
+					break;
+				}
+				default: Panic(fmt::format("Operand {} of {} can not be encoded", i, node->to_string()))
+			}
+		}
+		return;
+	}
+
+	switch (node->kind) {
+		case Kind::DATA_STATIC_NODE: {
+			auto data = (DataStaticNode*)node;
+			reg(data->data_register);
+			literal(data->literal);
+			return;
+		}
+		case Kind::DATA_TYPE_NODE: {
+			auto data = (DataTypeNode*)node;
+			reg(data->data_register);
+			varint(data->types.size());
+			For(data->types) byte((u8)it->kind);
+			return;
+		}
+		default: Panic(fmt::format("Can not encode instruction {}", node->to_string()))
+	}
+}
+
+}
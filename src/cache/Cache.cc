@@ -0,0 +1,195 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <cache/Cache.hh>
+#include <BuildId.hh>
+#include <binary/Binary.hh>
+#include <util/Hash.hh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hive::ir {
+
+static constexpr std::string_view ENTRY_SUFFIX = ".entry";
+static constexpr time_t STALE_TEMP_SECONDS = 60 * 60;
+
+static auto write_all(int fd, const char* data, size length) -> bool {
+	while (length > 0) {
+		auto put = ::write(fd, data, length);
+		if (put < 0 && errno == EINTR) continue;
+		if (put <= 0) return false;
+
+		data += put;
+		length -= put;
+	}
+	return true;
+}
+
+// The lock file holds the byte total of the entries, see trim()
+static auto save_total(int lock, u64 total) -> bool {
+	return ::pwrite(lock, &total, sizeof(total), 0) == sizeof(total);
+}
+
+Cache::Cache(std::string dir, size max_bytes) : dir(std::move(dir)), max_bytes(max_bytes) {}
+
+auto Cache::open() -> std::optional<Diagnostic> {
+	if (::mkdir(dir.c_str(), 0777) != 0 && errno != EEXIST) {
+		return Diagnostic{ErrorCode::IO_ERROR, fmt::format("Unable to create cache directory {}: {}", dir, std::strerror(errno))};
+	}
+	return std::nullopt;
+}
+
+auto Cache::key(std::string_view source, EmitKind kind) -> CacheKey {
+	static const u64 build = xxh64(build_id(), BINARY_VERSION);
+	return xxh64(source, build ^ (u8)kind);
+}
+
+auto Cache::entry_path(CacheKey key) const -> std::string {
+	return fmt::format("{}/{:016x}{}", dir, key, ENTRY_SUFFIX);
+}
+
+auto Cache::fetch(CacheKey key, const char* target) -> bool {
+	int fd = ::open(entry_path(key).c_str(), O_RDONLY | O_CLOEXEC);
+	struct stat info;
+
+	if (fd < 0 || ::fstat(fd, &info) != 0) {
+		if (fd >= 0) ::close(fd);
+		miss_count++;
+		return false;
+	}
+
+	const char* bytes = nullptr;
+	if (info.st_size > 0) {
+		auto mapped = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		bytes = mapped == MAP_FAILED ? nullptr : (const char*)mapped;
+	}
+
+	bool ok = info.st_size == 0 || bytes;
+
+	if (ok) {
+		int out = ::open(target, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+		ok = out >= 0 && write_all(out, bytes, info.st_size);
+		if (out >= 0) ::close(out);
+	}
+
+	if (bytes) ::munmap((void*)bytes, info.st_size);
+
+	// Note: The mtime is the entry's last use for trim(). Best effort, it fails for
+	//       entries another user wrote and those just age as if unused
+	if (ok) (void)::futimens(fd, nullptr);
+	::close(fd);
+
+	ok ? hit_count++ : miss_count++;
+	return ok;
+}
+
+auto Cache::store(CacheKey key, std::string_view bytes) -> void {
+	auto temp = fmt::format("{}/.tmp-{}-{}", dir, ::getpid(), temp_count++);
+	int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+
+	if (fd < 0) return;
+
+	bool ok = write_all(fd, bytes.data(), bytes.size());
+	ok = ::close(fd) == 0 && ok;
+
+	// Note: rename is atomic so a racing process sees the old entry or ours, an equal key means equal bytes either way
+	if (!ok || ::rename(temp.c_str(), entry_path(key).c_str()) != 0) {
+		::unlink(temp.c_str());
+		return;
+	}
+	stored_bytes += bytes.size();
+}
+
+auto Cache::trim() -> void {
+	size added = stored_bytes.exchange(0);
+	if (added == 0) return;
+
+	auto lock_path = fmt::format("{}/.lock", dir);
+	int lock = ::open(lock_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+
+	if (lock < 0) return;
+
+	if (::flock(lock, LOCK_EX) != 0) {
+		::close(lock);
+		return;
+	}
+
+	// Note: The total over counts an entry stored twice and misses ones removed by hand,
+	//       either way the next listing puts it right
+	u64 total  = 0;
+	bool known = ::pread(lock, &total, sizeof(total), 0) == sizeof(total);
+	total += added;
+
+	if (known && total <= max_bytes) {
+		save_total(lock, total);
+	} else {
+		evict(lock);
+	}
+
+	::flock(lock, LOCK_UN);
+	::close(lock);
+}
+
+// Lists every entry, evicts the least recently used past max_bytes and writes the total that is left to lock
+auto Cache::evict(int lock) -> void {
+	struct Entry {
+		std::string path;
+		size bytes;
+		timespec used;
+	};
+
+	std::vector<Entry> entries;
+	size total = 0;
+
+	if (auto listing = ::opendir(dir.c_str())) {
+		while (auto it = ::readdir(listing)) {
+			std::string_view name = it->d_name;
+			if (!name.ends_with(ENTRY_SUFFIX) && !name.starts_with(".tmp-")) continue;
+
+			auto path = fmt::format("{}/{}", dir, name);
+			struct stat info;
+
+			if (::stat(path.c_str(), &info) != 0) continue;
+
+			// temporaries only outlive a store when the process died mid write
+			if (name.starts_with(".tmp-")) {
+				if (::time(nullptr) - info.st_mtime > STALE_TEMP_SECONDS) ::unlink(path.c_str());
+			} else {
+				entries.push_back(Entry{std::move(path), (size)info.st_size, info.st_mtim});
+				total += info.st_size;
+			}
+		}
+		::closedir(listing);
+	}
+
+	if (total > max_bytes) {
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+			return a.used.tv_sec != b.used.tv_sec ? a.used.tv_sec < b.used.tv_sec : a.used.tv_nsec < b.used.tv_nsec;
+		});
+
+		for (auto& entry : entries) {
+			if (total <= max_bytes) break;
+			if (::unlink(entry.path.c_str()) == 0) total -= entry.bytes;
+		}
+	}
+
+	save_total(lock, total);
+}
+
+}
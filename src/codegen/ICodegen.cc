@@ -5,6 +5,7 @@
  */
 
 #include <codegen/ICodegen.hh>
+#include <err/Diagnostic.hh>
 
 #include <fmt/core.h>
 
@@ -13,7 +14,24 @@
 
 namespace hive::ir {
 
-ICodegen::ICodegen(const std::string name, ProgNode* program) : name(name), program(program) {}
+ICodegen::ICodegen(const std::string name, ProgNode* program) : program(program), flat(program), name(name) {}
+
+using Hook = auto (ICodegen::*)() -> void;
+
+// Note: One entry per INSTRUCTION_LIST row so the row is the whole dispatch
+static constexpr Hook hooks[] = {
+	#define Inst(token, node, cls, hook, ...) &ICodegen::hook,
+		INSTRUCTION_LIST
+	#undef Inst
+};
+
+auto ICodegen::emit(const FlatInst& inst) -> void {
+	current  = &inst;
+	auto row = instruction_by_node[(u8)inst.kind];
+
+	if (row == NO_INSTRUCTION) return instruction();
+	(this->*hooks[row])();
+}
 
 auto ICodegen::check(i8 n, Kind kind) -> bool {
 	return peek(n)->kind == kind;
@@ -52,9 +70,7 @@ auto ICodegen::write(std::string target) -> void {
 	std::FILE *file = std::fopen(target.c_str(), "w");
 
 	if (!file) {
-		std::free(file);
-		fmt::println("Unable to write file");
-		std::exit(-3);
+		compile_error(ErrorCode::IO_ERROR, fmt::format("Unable to write file {}", target));
 	}
 	std::fprintf(file, "%s", instruction_bufffer.c_str());
 	std::fclose(file);
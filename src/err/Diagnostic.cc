@@ -0,0 +1,21 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <err/Diagnostic.hh>
+
+#include <fmt/core.h>
+
+namespace hive::ir {
+
+auto compile_error(ErrorCode code, std::string message) -> void {
+	throw CompileError(Diagnostic{code, std::move(message)});
+}
+
+auto panic(const char* file, int line, std::string msg) -> void {
+	compile_error(ErrorCode::INTERNAL_ERROR, fmt::format("[PANIC] {}:{}\n{}", file, line, msg));
+}
+
+}
@@ -0,0 +1,151 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <node/FlatProgram.hh>
+#include <err/Diagnostic.hh>
+
+#include <fmt/core.h>
+
+namespace hive::ir {
+
+// The token behind any literal node, labels can be named by any of them
+static auto literal_token(Node* node) -> Token* {
+	switch (node->kind) {
+		case NodeKinds::STRING_LITERAL_NODE: return ((StringLiteralNode*)node)->ident;
+		case NodeKinds::IDENT_LITERAL_NODE: return ((IdentLiteralNode*)node)->ident;
+		case NodeKinds::HEX_LITERAL_NODE: return ((HexLiteralNode*)node)->ident;
+		case NodeKinds::DIGIT_LITERAL_NODE: return ((DigitLiteralNode*)node)->ident;
+		case NodeKinds::OCTAL_LITERAL_NODE: return ((OctalLiteralNode*)node)->ident;
+		case NodeKinds::BINARY_LITERAL_NODE: return ((BinaryLiteralNode*)node)->ident;
+		case NodeKinds::FLOAT_LITERAL_NODE: return ((FloatLiteralNode*)node)->ident;
+		default: Panic(fmt::format("{} is not a literal", node->to_string()))
+	}
+	return nullptr;
+}
+
+FlatProgram::FlatProgram(ProgNode* program) {
+	size instruction_count = 0;
+
+	For(program->nodes) {
+		if (it->kind == Kind::LABEL_NODE) instruction_count += ((LabelNode*)it)->instructions.size();
+	}
+	instructions.reserve(instruction_count);
+
+	For(program->nodes) {
+		if (it->kind == Kind::DIRECTIVE_NODE) {
+			directive((DirectiveNode*)it);
+			continue;
+		}
+
+		if (it->kind != Kind::LABEL_NODE) continue;
+
+		auto label = (LabelNode*)it;
+		auto first = instructions.size();
+
+		for (auto inst : label->instructions) {
+			instruction(inst);
+		}
+
+		labels.push_back(FlatLabel{literal_token(label->name)->name, (u32)first, (u32)label->instructions.size()});
+	}
+}
+
+auto FlatProgram::body(const FlatLabel& label) const -> std::span<const FlatInst> {
+	return std::span<const FlatInst>(instructions.data() + label.first, label.count);
+}
+
+auto FlatProgram::list(FlatOperand op) const -> std::span<const u32> {
+	return std::span<const u32>(extra.data() + op + 1, extra[op]);
+}
+
+auto FlatProgram::bytes() const -> size {
+	return instructions.capacity() * sizeof(FlatInst)
+		+ labels.capacity() * sizeof(FlatLabel)
+		+ literals.capacity() * sizeof(FlatLiteral)
+		+ directives.capacity() * sizeof(FlatDirective)
+		+ words.capacity() * sizeof(std::string_view)
+		+ extra.capacity() * sizeof(u32);
+}
+
+auto FlatProgram::directive(DirectiveNode* directive) -> void {
+	auto first = words.size();
+
+	For(directive->tokens) words.push_back(it->name);
+
+	directives.push_back(FlatDirective{(u32)labels.size(), literal(directive->name), (u32)first, (u32)(words.size() - first)});
+}
+
+auto FlatProgram::reg(Node* node) -> FlatOperand {
+	size id = 0;
+
+	switch (node->kind) {
+		case Kind::VIRTUAL_REGISTER_NODE: id = ((VirtualRegisterNode*)node)->id; break;
+		case Kind::DATA_REGISTER_NODE: id = ((DataRegisterNode*)node)->id; break;
+		default: Panic(fmt::format("{} is not a register", node->to_string()))
+	}
+
+	if (id > MAX_REGISTER) {
+		compile_error(ErrorCode::NOT_IMPLEMENTED, fmt::format("Register {} is past r{}, the last register codegen can hold", node->to_string(), MAX_REGISTER));
+	}
+	return (FlatOperand)id << 1 | (node->kind == Kind::DATA_REGISTER_NODE);
+}
+
+auto FlatProgram::literal(Node* node) -> FlatOperand {
+	auto ident = literal_token(node);
+
+	literals.push_back(FlatLiteral{node->kind, ident->name, ident->value});
+	return literals.size() - 1;
+}
+
+auto FlatProgram::instruction(Node* node) -> void {
+	auto& inst = instructions.emplace_back();
+	inst.kind  = node->kind;
+
+	auto set = [&inst](std::initializer_list<FlatOperand> ops) {
+		inst.count = 0;
+		for (auto op : ops) inst.ops[inst.count++] = op;
+	};
+
+	if (auto desc = find_instruction(node->kind)) {
+		InstructionOperands ops;
+		desc->operands_of(node, ops);
+		inst.count = desc->count;
+
+		for (u8 i = 0; i < desc->count; i++) {
+			switch (desc->operands[i]) {
+				case Operand::REG:
+				case Operand::VREG: inst.ops[i] = reg(ops.nodes[i]); break;
+				case Operand::LITERAL: inst.ops[i] = literal(ops.nodes[i]); break;
+				case Operand::REGS: {
+					inst.ops[i] = extra.size();
+					extra.push_back(ops.list.size());
+					For(ops.list) extra.push_back(reg(it));
+					break;
+				}
+				default: Panic(fmt::format("Operand {} of {} can not be flattened", i, node->to_string()))
+			}
+		}
+		return;
+	}
+
+	switch (node->kind) {
+		case Kind::DATA_STATIC_NODE: {
+			auto data = (DataStaticNode*)node;
+			return set({reg(data->data_register), literal(data->literal)});
+		}
+		case Kind::DATA_TYPE_NODE: {
+			auto data = (DataTypeNode*)node;
+			u32 list  = extra.size();
+
+			extra.push_back(data->types.size());
+			For(data->types) extra.push_back((u32)it->kind);
+			return set({reg(data->data_register), list});
+		}
+		default: Panic(fmt::format("Can not flatten instruction {}", node->to_string()))
+	}
+}
+
+}
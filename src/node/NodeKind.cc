@@ -5,22 +5,89 @@
  */
 
 #include <node/NodeKind.hh>
+
 namespace hive::ir {
 
-auto name_from_node(NodeKinds kind) -> std::string {
-	For(node_name_map) {
-		if (it.first == kind) {
-			return it.second;
-		}
+constexpr std::string_view node_kind_names[] = {
+	#define _Node(kind, name) name,
+		NODE_KIND_NAME_LIST
+	#undef _Node
+};
+
+constexpr NodeKinds node_kinds[] = {
+	#define _Node(kind, name) NodeKinds::kind,
+		NODE_KIND_NAME_LIST
+	#undef _Node
+};
+
+constexpr size NODE_KIND_COUNT = sizeof(node_kinds) / sizeof(node_kinds[0]);
+constexpr size NODE_NAME_TABLE_SIZE = 128;
+
+// Same scheme as the keyword table in TokenKind.cc, the _START/_END markers have no name and are left out
+constexpr auto node_name_hash(std::string_view str, u32 seed) -> u32 {
+	u32 hash = seed;
+	for (auto c : str) {
+		hash = (hash ^ (u8)c) * 16777619u;
 	}
-	return "INVALID";
+	return (hash ^ (hash >> 15)) & (NODE_NAME_TABLE_SIZE - 1);
 }
 
-auto node_from_name(std::string name) -> NodeKinds {
-	For(node_name_map) {
-		if (it.second == name) {
-			return it.first;
+constexpr auto find_node_name_seed() -> u32 {
+	for (u32 seed = 2166136261u;; seed++) {
+		bool used[NODE_NAME_TABLE_SIZE] = {};
+		bool collision = false;
+
+		for (size i = 0; i < NODE_KIND_COUNT && !collision; i++) {
+			if (node_kind_names[i].empty()) continue;
+
+			auto slot = node_name_hash(node_kind_names[i], seed);
+			collision  = used[slot];
+			used[slot] = true;
 		}
+
+		if (!collision) return seed;
+	}
+}
+
+constexpr u32 NODE_NAME_SEED = find_node_name_seed();
+
+struct NodeNameSlot {
+	std::string_view name;
+	NodeKinds kind = NodeKinds::INVALID;
+};
+
+struct NodeNameTable {
+	NodeNameSlot slots[NODE_NAME_TABLE_SIZE];
+};
+
+constexpr auto build_node_name_table() -> NodeNameTable {
+	NodeNameTable table;
+
+	for (size i = 0; i < NODE_KIND_COUNT; i++) {
+		if (node_kind_names[i].empty()) continue;
+
+		auto& slot = table.slots[node_name_hash(node_kind_names[i], NODE_NAME_SEED)];
+		slot.name = node_kind_names[i];
+		slot.kind = node_kinds[i];
+	}
+	return table;
+}
+
+constexpr NodeNameTable node_name_table = build_node_name_table();
+
+static_assert(node_name_table.slots[node_name_hash("ADD_NODE", NODE_NAME_SEED)].kind == NodeKinds::ADD_NODE);
+static_assert(node_name_table.slots[node_name_hash("JUMP_NODE", NODE_NAME_SEED)].kind == NodeKinds::JUMP_NODE);
+
+auto name_from_node(NodeKinds kind) -> std::string_view {
+	if ((size)kind >= NODE_KIND_COUNT) return "INVALID";
+	return node_kind_names[(u8)kind];
+}
+
+auto node_from_name(std::string_view name) -> NodeKinds {
+	auto& slot = node_name_table.slots[node_name_hash(name, NODE_NAME_SEED)];
+
+	if (slot.name == name) {
+		return slot.kind;
 	}
 	return NodeKinds::INVALID;
 }
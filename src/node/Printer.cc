@@ -0,0 +1,121 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <node/Printer.hh>
+
+namespace hive::ir {
+
+auto Printer::print(ProgNode* program) -> std::string {
+	out.clear();
+
+	For(program->nodes) {
+		if (it->kind == NodeKinds::LABEL_NODE) {
+			out.append("\n");
+			dispatch(it);
+		} else {
+			dispatch(it);
+			out.append("\n");
+		}
+	}
+	return std::move(out);
+}
+
+auto Printer::print(Node* node) -> std::string {
+	out.clear();
+	dispatch(node);
+	return std::move(out);
+}
+
+auto Printer::visit(LabelNode* label) -> void {
+	out.append("LABEL ");
+	dispatch(label->name);
+	out.append(":\n");
+
+	For(label->instructions) {
+		out.append("\t");
+		dispatch(it);
+		out.append("\n");
+	}
+}
+
+auto Printer::visit(DirectiveNode* directive) -> void {
+	out.append("#");
+	dispatch(directive->name);
+
+	For(directive->tokens) {
+		out.append(it->name);
+	}
+}
+
+auto Printer::visit(StringLiteralNode* node) -> void {
+	out.append("\"");
+	out.append(node->ident->name);
+	out.append("\"");
+}
+
+// Note: Numbers keep their token so they come back out the way they were written
+auto Printer::visit(IdentLiteralNode* node) -> void { out.append(node->ident->name); }
+auto Printer::visit(HexLiteralNode* node) -> void { out.append(node->ident->name); }
+auto Printer::visit(DigitLiteralNode* node) -> void { out.append(node->ident->name); }
+auto Printer::visit(OctalLiteralNode* node) -> void { out.append(node->ident->name); }
+auto Printer::visit(BinaryLiteralNode* node) -> void { out.append(node->ident->name); }
+auto Printer::visit(FloatLiteralNode* node) -> void { out.append(node->ident->name); }
+
+auto Printer::visit(VirtualRegisterNode* node) -> void { out.append(fmt::format("r{}", node->id)); }
+auto Printer::visit(DataRegisterNode* node) -> void { out.append(fmt::format("d{}", node->id)); }
+
+auto Printer::visit(DataStaticNode* data) -> void {
+	dispatch(data->data_register);
+	out.append(fmt::format(" {} ", data->ident->name));
+	dispatch(data->literal);
+}
+
+auto Printer::visit(DataTypeNode* data) -> void {
+	dispatch(data->data_register);
+	out.append(" {");
+
+	For(data->types) {
+		out.append(" ");
+		out.append(it->to_string());
+	}
+	out.append(" }");
+}
+
+// Instructions have no overload of their own, they all print through INSTRUCTION_LIST
+auto Printer::visit(Node* node) -> void {
+	if (auto desc = find_instruction(node->kind)) {
+		return instruction(node, *desc);
+	}
+	out.append(node->to_string());
+}
+
+// Same layout rules Parse::instruction reads, both come from INSTRUCTION_LIST
+auto Printer::instruction(Node* node, const InstructionDesc& desc) -> void {
+	InstructionOperands ops;
+	desc.operands_of(node, ops);
+	out.append(ops.ident->name);
+
+	for (u8 i = 0; i < desc.count; i++) {
+		if (desc.operands[i] == Operand::REGS) {
+			For(ops.list) {
+				out.append(" ");
+				dispatch(it);
+			}
+			continue;
+		}
+
+		switch (desc.before(i)) {
+			case TokenKind::COMMA: out.append(", "); break;
+			case TokenKind::DOT: out.append("."); break;
+			case TokenKind::RIGHT_ARROW: out.append(" -> "); break;
+			default: out.append(" ");
+		}
+
+		dispatch(ops.nodes[i]);
+	}
+}
+
+}
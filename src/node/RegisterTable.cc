@@ -0,0 +1,60 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <node/RegisterTable.hh>
+
+#include <fmt/format.h>
+
+#include <cstring>
+
+namespace hive::ir {
+
+RegisterTable::RegisterTable() : storage(16 * 1024) {}
+
+auto RegisterTable::virtual_register(size id) -> VirtualRegisterNode* {
+	std::lock_guard guard(lock);
+
+	auto& node = virtuals[id];
+	if (!node) {
+		node = storage.make<VirtualRegisterNode>(token(TokenKind::REGISTER, 'r', id), id);
+	}
+	return node;
+}
+
+auto RegisterTable::data_register(size id) -> DataRegisterNode* {
+	std::lock_guard guard(lock);
+
+	auto& node = datas[id];
+	if (!node) {
+		node = storage.make<DataRegisterNode>(token(TokenKind::DATA, 'd', id), id);
+	}
+	return node;
+}
+
+auto RegisterTable::count() const -> size {
+	std::lock_guard guard(lock);
+	return virtuals.size() + datas.size();
+}
+
+auto RegisterTable::clear() -> void {
+	std::lock_guard guard(lock);
+
+	virtuals.clear();
+	datas.clear();
+	storage.reset();
+}
+
+// Note: The canonical node is not any one use of the register so its token only has the name
+auto RegisterTable::token(TokenKind kind, char prefix, size id) -> Token* {
+	char name[24];
+	auto len   = fmt::format_to_n(name, sizeof(name), "{}{}", prefix, id).size;
+	auto bytes = (char*)storage.alloc(len, 1);
+
+	std::memcpy(bytes, name, len);
+	return storage.make<Token>(std::string_view(bytes, len), kind, Pos());
+}
+
+}
@@ -1,191 +1,220 @@
 #include <Defs.hh>
 #include <token/Token.hh>
 #include <parse/Lex.hh>
+#include <parse/LexTable.hh>
 
 #include <fmt/core.h>
 
+#include <bit>
 #include <cstdlib>
-#include <cstdio>
 
 namespace hive::ir {
 
-Lex::Lex(const char* target, LexMode mode) {
-	load_target(target);
+Lex::Lex(const char* target, LexMode mode, Context* ctx) : ctx(ctx), arena(&ctx->arena), mode(mode) {
 	this->target = target;
+	this->file   = ctx->sources.add(target);
+	load_target(target);
+
+	start(0, ctx->sources.file(file).buffer.length());
+}
+
+Lex::Lex(Context* ctx, FileId file, size begin, size end, Arena* arena, LexMode mode) : ctx(ctx), arena(arena), mode(mode) {
+	this->target = std::string(ctx->sources.path(file));
+	this->file   = file;
+	this->buffer = ctx->sources.file(file).buffer.data();
 
-	//Hack(anita): Added this here because version must be at the top of this and this is a look ahead
-	if (check(0,'#')) {
-		tokens.push_back(new Token(Kind::POUND, Pos(target, idx, line, column, idx)));
+	start(begin, end);
+}
+
+auto Lex::start(size begin, size end) -> void {
+	limit = end;
+
+	if (begin == 0) {
+		//Hack(anita): Added this here because version must be at the top of this and this is a look ahead
+		if (!check(0,'#')) {
+			lex_error("Must start with a version directive");
+		}
+		at_start = true;
 	} else {
-		lex_error("Must start with a version directive");
+		idx = begin - 1;
+	}
+}
+
+auto Lex::next(TokenBuffer& out) -> void {
+	this->out = &out;
+
+	if (at_start) {
+		at_start = false;
+		out.push(Kind::POUND, Trivia::NONE, 0, 0, 1);
+		return;
+	}
+
+	if (mode == LexMode::TRIVIA_FREE && (check(' ') || check('\t'))) {
+		scan_trivia();
+	}
+
+	if (idx + 1 >= limit || peek() == '\0') {
+		out.push(Kind::_EOF, blank, blank_width, idx + 1, 0);
+		blank = Trivia::NONE;
+		blank_width = 0;
+		return;
+	}
+
+	scan_token();
+	advance();
+}
+
+auto Lex::token(const TokenBuffer& tokens, size n) -> Token {
+	auto kind   = tokens.kind(n);
+	auto offset = tokens.offset(n);
+	auto length = tokens.length(n);
+	auto pos    = Pos(file, offset, length);
+
+	if (kind == Kind::_EOF) {
+		return Token(kind, pos);
 	}
 
-	while (peek() != '\0') {
-		auto token = scan_token();
-		tokens.push_back(token);
-		advance();
+	auto token = Token(std::string_view(buffer + offset, length), kind, pos);
+
+	if (kind == Kind::IDENT_LITERAL) {
+		token.symbol = ctx->interner.intern(token.name);
+	} else if (kind == Kind::FLOAT_LITERAL) {
+		token.value.real = std::bit_cast<double>(tokens.value(n));
+	} else {
+		token.value.integer = tokens.value(n);
 	}
+	return token;
+}
 
-	tokens.push_back(new Token(Kind::_EOF, Pos(target, idx + 1, line + 1, 1, idx + 1)));
+auto Lex::name(const TokenBuffer& tokens, size n) -> std::string_view {
+	return std::string_view(buffer + tokens.offset(n), tokens.length(n));
 }
 
-auto Lex::scan_token() -> Token* {
+/**
+ * Skips a run of blanks without making a token for it, the run is recorded
+ * on the token that follows. The first blank decides the kind and the width
+ * is kept so the parser can still tell one blank from several.
+ */
+auto Lex::scan_trivia() -> void {
 	size start = idx;
-	switch(peek()) {
-		case '\n': {
-			line   = line + 1;
-			column = column = 1;
-			return new Token(Kind::EOL, Pos(target, start, line, column, idx));
-		}
-		case '\t': return new Token(Kind::TAB, Pos(target, start, line, column, idx));
-		case ' ': return new Token(Kind::SPACE, Pos(target, start, line, column, idx));
-		case '\0': return new Token(Kind::_EOF, Pos(target, start, line, column, idx));
-		case '-': {
+	blank = check('\t') ? Trivia::TAB : Trivia::SPACE;
+	advance_to(scan->blank_end(buffer + idx + 1));
+	blank_width = idx - start;
+}
+
+auto Lex::scan_token() -> void {
+	size start = idx;
+	char c     = peek();
+
+	switch (lex_table::char_classes[(u8)c]) {
+		case CharClass::EOL: return make_token(Kind::EOL, start);
+		// One token per blank, the parser relies on that to reject doubled blanks
+		case CharClass::BLANK: return make_token(c == '\t' ? Kind::TAB : Kind::SPACE, start);
+		case CharClass::END: return make_token(Kind::_EOF, start);
+		case CharClass::DASH: {
 			if (check(2, '>')) {
 				advance();
-				return new Token(Kind::RIGHT_ARROW, Pos(target, start, line, column, idx));
+				return make_token(Kind::RIGHT_ARROW, start);
 			}
-			return new Token(Kind::DASH, Pos(target, start, line, column, idx));
+			return make_token(Kind::DASH, start);
 		}
-		case ',': return new Token(Kind::COMMA, Pos(target,  start, line, column, idx));
-		case ':': return new Token(Kind::COLON, Pos(target, start, line, column, idx));
-		case '#': return new Token(Kind::POUND, Pos(target, start, line, column, idx));
-		case '|': return new Token(Kind::PIPE, Pos(target, start, line, column, idx));
-		case '(': return new Token(Kind::OPEN_BRACE, Pos(target, start, line, column, idx));
-		case ')': return new Token(Kind::CLOSE_PARAN, Pos(target, start, line, column, idx));
-		case '{': return new Token(Kind::OPEN_BRACE, Pos(target, start, line, column, idx));
-		case '}': return new Token(Kind::CLOSE_BRACE, Pos(target, start, line, column, idx));
-		case '[': return new Token(Kind::OPEN_BRACKET, Pos(target, start, line, column, idx));
-		case ']': return new Token(Kind::CLOSE_BRACKET, Pos(target, start, line, column, idx));
-		case 'r': {
-			std::string str = "";
-			str.push_back(peek()); // eat the r
-			advance();
-			for(;;) {
-				if (!is_digit()) break; // break out if it's the next digit is not 0-9
-				advance();
-			}
-			idx--; // ugly hack to restore the state
-			return new Token(str, Kind::REGISTER, Pos(target, start, line, column, idx));
-		}
-		case 'd': {
-			std::string str = "";
-			str.push_back(peek()); // eat the r
-			advance();
-			for(;;) {
-				if (!is_digit()) break; // break out if it's the next digit is not 0-9
-
-				str.push_back(peek());
-				advance();
-			}
-			idx--; // ugly hack to restor the state
-			return new Token(str, Kind::DATA, Pos(target, start, line, column, idx));
+		case CharClass::PUNCT:
+		case CharClass::DOT: return make_token(lex_table::punct_kinds[(u8)c], start);
+		case CharClass::QUOTE: return concat_string();
+		case CharClass::INVALID: {
+			lex_error(fmt::format("invalid token being lexed '{}' @ {}", c, where(idx + 1)));
+			return;
 		}
-		case '"': {
-			tokens.push_back(new Token(Kind::DOUBLE_QUOTE, Pos(target, start, line, column, idx)));
-			advance();
+		default: return concat_word();
+	}
+}
 
-			auto local_start = idx;
-			std::string str = concat_string();
-			tokens.push_back(new Token(str,Kind::STRING_LITERAL, Pos(target, local_start, line, column, idx)));
+/**
+ * Tokens span from the char after start up to and including the char after
+ * idx, the same look ahead of one that peek() uses.
+ */
+auto Lex::text(size start) -> std::string_view {
+	return std::string_view(buffer + start + 1, idx - start + 1);
+}
 
-			if (!check('"')) {
-				lex_error("Expected a '\"' and failed");
-			}
-			return new Token(Kind::DOUBLE_QUOTE, Pos(target, idx, line, column, idx));
-		}
-		case '.': return new Token(Kind::DOT, Pos(target, start, line, column, idx));
-		default: {
-			if (is_digit()) {
-				return concat_number();
-			} else if (is_alpha_num()) {
-				return concat_ident();
-			} else {
-				lex_error(fmt::format("invalid token being lexed '{}' @ {}:{}", peek(), line, column));
-			}
-		}
-	}
-	return nullptr;
+auto Lex::make_token(Kind kind, size start, u64 value) -> void {
+	out->push(kind, blank, blank_width, start + 1, idx - start + 1, value);
+	blank = Trivia::NONE;
+	blank_width = 0;
 }
 
-auto Lex::concat_string() -> std::string  {
-	std::string str = "";
+// Numbers and registers are decoded here once so nothing later parses their text again
+auto Lex::make_number(Kind kind, size start) -> void {
+	TokenValue value = {0};
+	auto name = text(start);
+
+	// Note: A bare r or d is left for the parser to complain about, see Parse::register_id
+	if ((kind == Kind::REGISTER || kind == Kind::DATA) && name.size() == 1) {
+		return make_token(kind, start);
+	}
 
-	while(peek() != '"') {
-		str.push_back(peek());
-		advance();
+	auto ec = decode_number(kind, name, value);
+	if (ec == std::errc::result_out_of_range) {
+		lex_error(fmt::format("'{}' is out of range @ {}", name, where(start + 1)));
+	} else if (ec != std::errc()) {
+		lex_error(fmt::format("Malformed number '{}' @ {}", name, where(start + 1)));
 	}
-	return str;
+
+	make_token(kind, start, kind == Kind::FLOAT_LITERAL ? std::bit_cast<u64>(value.real) : value.integer);
 }
 
-auto Lex::concat_number() -> Token* {
-	std::string str = "";
-	size start = idx;
-	bool has_dot = false;
-
-	if (check('0')) {
-		str.push_back(peek());
-		advance();
-		if (check('x')) {
-			str.push_back(peek());
-			advance();
-			while(is_hex()) {
-				str.push_back(peek());
-				advance();
-				return new Token(str, Kind::HEX_LITERAL, Pos(target, start, line, column, idx));
-			}
-		} else if (check('b')) {
-			str.push_back(peek());
-			advance();
-			while(is_binary()) {
-				str.push_back(peek());
-				advance();
-				return new Token(str, Kind::BINARY_LITERAL, Pos(target, start, line, column, idx));
-			}
+auto Lex::concat_string() -> void {
+	size open = idx + 1;
+	make_token(Kind::DOUBLE_QUOTE, idx);
+	advance();
 
-		} else if (check('o')) {
-			str.push_back(peek());
-			advance();
-			while(is_octal()) {
-				str.push_back(peek());
-				advance();
-				return new Token(str, Kind::OCTAL_LITERAL, Pos(target, start, line, column, idx));
-			}
-		}
+	size start = idx;
+	auto close = scan->quote_end(buffer + idx + 1);
+	if (*close != '"') {
+		lex_error(fmt::format("Unterminated string starting @ {}", where(open)));
 	}
 
-	while (is_alpha() || check('.')) {
-		if (check('.')) {
-			if (has_dot == false) {
-				has_dot = true;
-				str.push_back(peek());
-				advance();
-			} else {
+	last_at(close);
+	make_token(Kind::STRING_LITERAL, start);
+	advance();
+	make_token(Kind::DOUBLE_QUOTE, idx);
+}
+
+/**
+ * Identifiers, keywords, registers and numbers. The DFA in LexTable.hh
+ * walks the word a byte at a time and stops on the first byte that is not
+ * part of it, the state it was in gives the kind.
+ */
+auto Lex::concat_word() -> void {
+	size start = idx;
+	auto ptr   = buffer + idx + 1;
+	auto state = LexState::START;
+
+	for (;;) {
+		auto next = lex_table::transitions[(size)state][(u8)*ptr];
+		if (next >= LexState::DONE) {
+			if (next == LexState::BAD_FLOAT) {
 				lex_error("To many dots in float literal");
 			}
+			break;
 		}
+		state = next;
+		ptr++;
 
-		str.push_back(peek());
-		advance();
-	}
-
-	if (has_dot) {
-		return new Token(str, Kind::FLOAT_LITERAL, Pos(target, start, line, column, idx));
-	} else {
-		return new Token(str, Kind::DIGIT_LITERAL, Pos(target, start, line, column, idx));
+		// Note: Nothing leaves IDENT until the word ends, so the rest of it goes to the SIMD scan
+		if (state == LexState::IDENT) {
+			ptr = scan->ident_end(ptr);
+			break;
+		}
 	}
-}
 
-auto Lex::concat_ident() -> Token* {
-	std::string str = "";
-	size start = idx;
+	last_at(ptr);
 
-	while (is_alpha_num()) {
-		str.push_back(peek());
-		advance();
+	auto kind = lex_table::accept_kind(state);
+	if (kind == Kind::IDENT_LITERAL) {
+		return make_token(kind_from_name(text(start)), start);
 	}
-	idx--;//Note(anita):  A gross hack I know but I don't care 4/14/2023
-	return new Token(str, Pos(target, start, line, column, idx));
+	return make_number(kind, start);
 }
 
 auto Lex::peek(i8 n) -> char { return buffer[idx + n];}
@@ -194,58 +223,36 @@ auto Lex::peek() -> char { return peek(1); }
 auto Lex::check(i8 n, char c) -> bool { return peek(n) == c;}
 auto Lex::check(char c) -> bool { return check(1, c); }
 
-auto Lex::advance(i8 n) -> void {
+auto Lex::advance(size n) -> void {
 	idx = idx + n;
-	column = column + n;
 }
 
 auto Lex::advance() -> void { advance(1); }
 
-auto Lex::is_hex() -> bool {return (peek() >= 'A' && peek() <= 'F') || (peek() >= 'a' && peek() <= 'f') || is_digit();}
-auto Lex::is_digit() -> bool { return peek() >= '0' && peek() <= '9';}
-auto Lex::is_octal() -> bool {return peek() >= '0' && peek() <= '7';}
-auto Lex::is_binary() -> bool {return (peek() == '0') || (peek() == '1');}
+// Moves so that end is the next char to be peeked
+auto Lex::advance_to(const char* end) -> void { advance(end - (buffer + idx + 1)); }
 
-auto Lex::is_alpha() -> bool { return (peek() >= 'a' && peek() <= 'z') || (peek() >= 'A' && peek() <= 'Z'); }
-auto Lex::is_alpha_num() -> bool { return is_alpha() || is_digit() || check('_'); }
-auto Lex::is_ident() -> bool{ return check('_') || is_digit() || is_alpha(); }
+// Moves so that the char before end is the last one in the token being made, next() steps past it
+auto Lex::last_at(const char* end) -> void { advance(end - (buffer + idx + 2)); }
+
+// Line and column of a byte in the buffer, only worked out for errors
+auto Lex::where(size offset) -> std::string {
+	auto loc = ctx->sources.location(file, offset);
+	return fmt::format("{}:{}", loc.line, loc.column);
+}
 
 auto Lex::lex_error(std::string msg) -> void {
-	fmt::println("Lex Error: {}", msg);
-	std::exit(-1);
+	compile_error(ErrorCode::LEX_ERROR, fmt::format("Lex Error: {}", msg));
 }
 
 
 auto Lex::load_target(const char* f) -> void {
+	auto& source = ctx->sources.file(file).buffer;
 
-	std::FILE* fptr;
-	fptr = std::fopen(f, "r");
-
-	if (!fptr) {
-		lex_error(fmt::format("No file {} found", target));
-	}
-	size buffer_size;
-
-	std::fseek(fptr, 0L, SEEK_END);
-	buffer_size = std::ftell(fptr);
-	std::rewind(fptr);
-
-	buffer = (char*)std::calloc(1, buffer_size + 1);
-
-	if (!buffer) {
-		std::fclose(fptr);
-		std::free(buffer);
-		lex_error("Unable to allocate memry to char buffer");
+	if (!source.load(f)) {
+		lex_error(source.error);
 	}
-
-	if (1 != std::fread(buffer, buffer_size, 1, fptr)) {
-		std::fclose(fptr);
-		std::free(buffer);
-		lex_error(fmt::format("Failed to read {}", target));
-	}
-
-	std::fclose(fptr);
-
+	buffer = source.data();
 }
 
 }
@@ -0,0 +1,111 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <parse/ModuleState.hh>
+#include <BuildId.hh>
+#include <util/Hash.hh>
+
+#include <fmt/core.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include <unistd.h>
+
+namespace hive::ir {
+
+auto ModuleState::hash(std::string_view source) -> u64 {
+	static const u64 build = xxh64(build_id(), VERSION);
+	return xxh64(source, build);
+}
+
+auto ModuleState::load(const char* path) -> void {
+	segments.clear();
+	by_hash.clear();
+
+	if (::access(path, R_OK) != 0 || !file.load(path)) return;
+
+	auto ptr = file.data();
+	auto end = file.data() + file.length();
+
+	u32 version;
+	u64 count;
+
+	if (end - ptr < 16 || std::memcmp(ptr, MAGIC, sizeof(MAGIC)) != 0) return;
+	std::memcpy(&version, ptr + 4, sizeof(version));
+	std::memcpy(&count, ptr + 8, sizeof(count));
+	ptr += 16;
+
+	if (version != VERSION) return;
+
+	std::vector<Segment> read;
+
+	for (u64 i = 0; i < count; i++) {
+		u64 hash, length;
+
+		if (end - ptr < 16) return;
+		std::memcpy(&hash, ptr, sizeof(hash));
+		std::memcpy(&length, ptr + 8, sizeof(length));
+		ptr += 16;
+
+		if ((u64)(end - ptr) < length) return;
+		read.push_back(Segment{hash, std::string_view(ptr, length)});
+		ptr += length;
+	}
+
+	// Note: Only a state that read back whole is used, a torn one would splice in garbage
+	segments = std::move(read);
+	for (u32 i = 0; i < segments.size(); i++) {
+		by_hash.emplace(segments[i].hash, i);
+	}
+}
+
+auto ModuleState::find(u64 hash) const -> const Segment* {
+	auto found = by_hash.find(hash);
+	return found == by_hash.end() ? nullptr : &segments[found->second];
+}
+
+auto ModuleState::add(u64 hash, std::string text) -> void {
+	auto& kept = owned.emplace_back(std::move(text));
+	by_hash.emplace(hash, (u32)segments.size());
+	segments.push_back(Segment{hash, kept});
+}
+
+auto ModuleState::reuse(const Segment& segment) -> void {
+	by_hash.emplace(segment.hash, (u32)segments.size());
+	segments.push_back(segment);
+}
+
+auto ModuleState::save(const char* path) const -> bool {
+	auto temp = fmt::format("{}.tmp-{}", path, ::getpid());
+	std::FILE* out = std::fopen(temp.c_str(), "wb");
+
+	if (!out) return false;
+
+	u64 count = segments.size();
+	bool ok = std::fwrite(MAGIC, 1, sizeof(MAGIC), out) == sizeof(MAGIC)
+		&& std::fwrite(&VERSION, sizeof(VERSION), 1, out) == 1
+		&& std::fwrite(&count, sizeof(count), 1, out) == 1;
+
+	for (auto& segment : segments) {
+		if (!ok) break;
+
+		u64 length = segment.text.size();
+		ok = std::fwrite(&segment.hash, sizeof(segment.hash), 1, out) == 1
+			&& std::fwrite(&length, sizeof(length), 1, out) == 1
+			&& std::fwrite(segment.text.data(), 1, length, out) == length;
+	}
+
+	ok = std::fclose(out) == 0 && ok;
+
+	if (!ok || std::rename(temp.c_str(), path) != 0) {
+		std::remove(temp.c_str());
+		return false;
+	}
+	return true;
+}
+
+}
@@ -0,0 +1,209 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <parse/ParallelParse.hh>
+
+#include <cstring>
+#include <exception>
+#include <memory>
+
+namespace hive::ir {
+
+ParallelParse::ParallelParse(const char* target, Context* ctx, size threads) : ctx(ctx), threads(threads) {
+	if (this->threads == 0) {
+		this->threads = ThreadPool::hardware_threads();
+	}
+
+	file = ctx->sources.add(target);
+
+	auto& source = ctx->sources.file(file).buffer;
+	if (!source.load(target)) {
+		parse_error(source.error);
+	}
+
+	buffer = source.data();
+	length = source.length();
+}
+
+auto ParallelParse::construct() -> ProgNode* {
+	std::unique_ptr<ThreadPool> pool;
+	if (threads > 1) {
+		pool = std::make_unique<ThreadPool>(threads);
+	}
+
+	auto starts = label_starts(pool.get());
+	size header_end = starts.empty() ? length : starts.front().offset;
+
+	// directives at the top are parsed here, the pool only ever sees labels
+	Lex header_lex(ctx, file, 0, header_end, &ctx->arena, LexMode::TRIVIA_FREE);
+	auto header = Parse(&header_lex).construct();
+
+	std::vector<Node*> nodes = std::move(header->nodes);
+	if (starts.empty()) {
+		return ctx->arena.make<ProgNode>(std::move(nodes), &ctx->arena);
+	}
+
+	// Note: More chunks than threads so one slow chunk does not hold up the rest
+	size chunk_count = threads * 4;
+	size max_chunks  = (length - header_end) / MIN_CHUNK_BYTES + 1;
+	if (chunk_count > max_chunks) chunk_count = max_chunks;
+	if (chunk_count > starts.size()) chunk_count = starts.size();
+
+	std::vector<Boundary> chunks;
+	size per_chunk = (length - header_end) / chunk_count + 1;
+
+	For(starts) {
+		if (chunks.empty() || it.offset - chunks.back().offset >= per_chunk) {
+			chunks.push_back(it);
+		}
+	}
+
+	struct Result {
+		std::unique_ptr<Arena> arena;
+		std::vector<Node*> nodes;
+		std::exception_ptr error;
+	};
+	std::vector<Result> results(chunks.size());
+
+	auto parse_chunk = [this, &chunks, &results](size i) {
+		size end = i + 1 < chunks.size() ? chunks[i + 1].offset : length;
+		auto& result = results[i];
+
+		result.arena = std::make_unique<Arena>();
+
+		// Note: Nothing may escape a pool thread, the error is rethrown once every chunk is done
+		try {
+			Lex lex(ctx, file, chunks[i].offset, end, result.arena.get(), LexMode::TRIVIA_FREE);
+			result.nodes = std::move(Parse(&lex).construct()->nodes);
+		} catch (...) {
+			result.error = std::current_exception();
+		}
+	};
+
+	if (chunks.size() == 1 || !pool) {
+		for (size i = 0; i < chunks.size(); i++) parse_chunk(i);
+	} else {
+		for (size i = 0; i < chunks.size(); i++) {
+			pool->submit([i, &parse_chunk] { parse_chunk(i); });
+		}
+		pool->wait();
+	}
+
+	// the first error in source order, the same one a serial parse stops at
+	For(results) {
+		if (it.error) std::rethrow_exception(it.error);
+	}
+
+	size total = nodes.size();
+	For(results) total += it.nodes.size();
+	nodes.reserve(total);
+
+	For(results) {
+		nodes.insert(nodes.end(), it.nodes.begin(), it.nodes.end());
+		ctx->arena.adopt(*it.arena);
+	}
+
+	return ctx->arena.make<ProgNode>(std::move(nodes), &ctx->arena);
+}
+
+auto ParallelParse::segments() -> std::vector<std::pair<size, size>> {
+	std::vector<std::pair<size, size>> found;
+	size begin = 0;
+
+	For(label_starts(nullptr)) {
+		if (it.offset > begin) found.push_back({begin, it.offset});
+		begin = it.offset;
+	}
+
+	if (length > begin) found.push_back({begin, length});
+	return found;
+}
+
+auto ParallelParse::parse_segment(std::pair<size, size> segment) -> ProgNode* {
+	Lex lex(ctx, file, segment.first, segment.second, &ctx->arena, LexMode::TRIVIA_FREE);
+	return Parse(&lex).construct();
+}
+
+/**
+ * Offsets of every line that starts with LABEL outside of a string.
+ *
+ * The buffer is cut at newlines into one part per thread and the parts are
+ * scanned at the same time. A part does not know if it begins inside a
+ * string someone opened before it, so it records its LABEL lines for both
+ * cases and counts its quotes. Walking the parts in order the quote parity
+ * so far says which of the two lists is the real one, which gives the same
+ * answer as one scan over the whole buffer.
+ */
+auto ParallelParse::label_starts(ThreadPool* pool) -> std::vector<Boundary> {
+	std::vector<ScanPart> parts;
+	size count = pool && length >= 2 * MIN_CHUNK_BYTES ? pool->thread_count() : 1;
+
+	for (size i = 0; i < count; i++) {
+		size begin = i == 0 ? 0 : length * i / count;
+
+		if (i != 0) {
+			auto eol = (const char*)std::memchr(buffer + begin, '\n', length - begin);
+			begin = eol ? eol - buffer + 1 : length;
+		}
+
+		if (!parts.empty()) {
+			if (begin <= parts.back().begin) continue;
+			parts.back().end = begin;
+		}
+		auto& part = parts.emplace_back();
+		part.begin = begin;
+		part.end   = length;
+	}
+
+	if (parts.size() == 1) {
+		scan_part(parts[0]);
+	} else {
+		for (auto& part : parts) {
+			pool->submit([this, &part] { scan_part(part); });
+		}
+		pool->wait();
+	}
+
+	std::vector<Boundary> starts;
+	u8 in_string = 0;
+
+	For(parts) {
+		auto& found = it.starts[in_string];
+		starts.insert(starts.end(), found.begin(), found.end());
+		in_string ^= it.quotes & 1;
+	}
+	return starts;
+}
+
+auto ParallelParse::scan_part(ScanPart& part) -> void {
+	auto ptr    = buffer + part.begin;
+	auto end    = buffer + part.end;
+	u8 parity   = 0;
+
+	while (ptr < end) {
+		// Note: Only a candidate, starts[1] is the list for a part that begins inside a string
+		if (buffer + length - ptr >= 5 && std::memcmp(ptr, "LABEL", 5) == 0) {
+			part.starts[parity].push_back(Boundary{(size)(ptr - buffer)});
+		}
+
+		auto eol      = (const char*)std::memchr(ptr, '\n', end - ptr);
+		auto line_end = eol ? eol : end;
+
+		for (auto quote = ptr; (quote = (const char*)std::memchr(quote, '"', line_end - quote)); quote++) {
+			parity ^= 1;
+			part.quotes++;
+		}
+
+		if (!eol) break;
+		ptr = eol + 1;
+	}
+}
+
+auto ParallelParse::parse_error(std::string msg) -> void {
+	compile_error(ErrorCode::PARSE_ERROR, fmt::format("Parse Error: {}", msg));
+}
+
+}
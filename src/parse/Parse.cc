@@ -11,22 +11,32 @@ namespace hive::ir {
 Parse::Parse(Lex* lex) {
 	this->idx = -1;
 	this->lex = lex;
+	this->arena = lex->arena;
+	this->trivia_free = lex->mode == LexMode::TRIVIA_FREE;
+	this->virtuals.resize(REGISTER_CACHE, nullptr);
+	this->datas.resize(REGISTER_CACHE, nullptr);
 }
 
 auto Parse::construct() -> ProgNode* {
 	std::vector<Node*> nodes;
 	while(!check(Kind::_EOF)) {
+		// blank lines between groups
+		if (check(Kind::EOL)) {
+			skip(Kind::EOL);
+			continue;
+		}
+
 		auto grp = groups();
 		nodes.push_back(grp);
 	}
-	return new ProgNode(nodes);
+	return arena->make<ProgNode>(std::move(nodes), arena);
 }
 
 auto Parse::groups() -> Node* {
-	switch(peek()->kind) {
+	switch(kind()) {
 		case Kind::POUND: {
 			auto direct = directive();
-			consume(Kind::EOL);
+			skip(Kind::EOL);
 			return direct;
 		}
 		case Kind::LABEL: {
@@ -34,10 +44,10 @@ auto Parse::groups() -> Node* {
 		}
 		case Kind::FUNCTION: not_impl("FUNCTION");
 		case Kind::EOL:
-			consume(Kind::EOL);
+			skip(Kind::EOL);
 			return groups();
 		default: {
-			parse_error(fmt::format("Illegal token '{}' found  for group.", peek()->short_to_string()));
+			parse_error(fmt::format("Illegal token '{}' found  for group.", token().short_to_string(lex->ctx->sources)));
 		}
 	}
 	return nullptr;
@@ -45,94 +55,111 @@ auto Parse::groups() -> Node* {
 
 auto Parse::label() -> Node* {
 	auto label = consume(Kind::LABEL);
-	consume(Kind::SPACE);
+	space();
 	auto name = literal();
-	consume(Kind::COLON);
-	consume(Kind::EOL);
-	std::vector<Node*> instructions;
+	skip(Kind::COLON);
+	skip(Kind::EOL);
+
+	// Note: Collected in a vector kept across labels so each label allocates once, at its final size
+	body.clear();
 
 	for(;;) {
-		if (!check(Kind::TAB))  break;
-		consume(Kind::TAB);
-		auto inst = instruction();
-		DebugInfo(fmt::format("\t{}", inst->to_string()))
-		instructions.push_back(inst);
-		consume(Kind::EOL);
+		if (!is_blank(Trivia::TAB))  break;
+		tab();
+		body.push_back(instruction());
+		skip(Kind::EOL);
 	}
 
-	DebugInfo(peek()->name)
-
-	return new LabelNode(label, name, instructions);
+	return arena->make<LabelNode>(label, name, std::vector<Node*>(body.begin(), body.end()));
 }
 
+/**
+ * Everything after the tab of an instruction line. The opcode picks its row
+ * in INSTRUCTION_LIST, which says what operands follow and how they are
+ * separated, and the row's InstructionNode builds the node.
+ */
 auto Parse::instruction() -> Node* {
-	switch(peek()->kind) {
-		case Kind::ADD: return bi_node();
-		case Kind::DATA: return data();
-		case Kind::SUBTRACT: return bi_node();
-		case Kind::DIVIDE: return bi_node();
-		case Kind::MULTIPLY: return bi_node();
-		case Kind::AND: return bi_node();
-		case Kind::OR: return bi_node();
-		case Kind::XOR: return bi_node();
-		case Kind::NOT: return _not();
-		case Kind::COMPARE_EQUALITY: return compare();
-		case Kind::COMPARE_GREATER_THAN: return compare();
-		case Kind::COMPARE_LESS_THAN: return compare();
-		case Kind::JUMP: return jump();
-		case Kind::JUMP_IF: return jump();
-		case Kind::JUMP_NOT_EQUAL: return jump();
-		case Kind::RETURN: return  _return();
-		case Kind::DEREF: return de_ref();
-		case Kind::POINTERTO: return ptr_to();
-		case Kind::CALL: return call();
-		case Kind::STORE: return store();
-		case Kind::WRITE: return write();
-		case Kind::_DEBUG: {
-				parse_error("DEBUG is not implemented!");
-		};
-
-		default:
-			parse_error(fmt::format("Illegal token found {}", peek()->to_string()));
+	if (check(Kind::DATA)) return data();
+	if (check(Kind::_DEBUG)) parse_error("DEBUG is not implemented!");
+
+	auto desc = find_instruction(kind());
+	if (!desc) parse_error(fmt::format("Illegal token found {}", describe(token())));
+
+	InstructionOperands ops;
+	ops.ident = take();
+
+	for (u8 i = 0; i < desc->count; i++) {
+		auto operand = desc->operands[i];
+
+		if (operand == Operand::REGS) {
+			regs.clear();
+			for(;;) {
+				if (check(Kind::EOL)) break;
+				space();
+				regs.push_back(reg());
+			}
+			ops.list.assign(regs.begin(), regs.end());
+			continue;
+		}
+
+		switch (desc->before(i)) {
+			case Kind::COMMA: skip(Kind::COMMA); space(); break;
+			case Kind::DOT: skip(Kind::DOT); break;
+			case Kind::RIGHT_ARROW: space(); skip(Kind::RIGHT_ARROW); space(); break;
+			default: space();
+		}
+
+		switch (operand) {
+			case Operand::REG: ops.nodes[i] = reg(); break;
+			case Operand::VREG: ops.nodes[i] = v_register(); break;
+			case Operand::LITERAL: ops.nodes[i] = literal(); break;
+			default: Panic(fmt::format("Operand {} of {} has no parse", i, name_from_kind(desc->token)))
+		}
 	}
-	return nullptr;
+
+	return desc->make(arena, ops, desc->node);
 }
 
 auto Parse::literal() -> Node* {
 
 	if (check(Kind::IDENT_LITERAL)) {
 		auto ident = consume(Kind::IDENT_LITERAL);
-		return new IdentLiteralNode(ident);
+		return arena->make<IdentLiteralNode>(ident);
 	}
 
 	if (check(Kind::DOUBLE_QUOTE)) {
 		auto start = consume(Kind::DOUBLE_QUOTE);
 		auto ident = consume(Kind::STRING_LITERAL);
 		auto end   = consume(Kind::DOUBLE_QUOTE);
-		return new StringLiteralNode(start, ident, end);
+		return arena->make<StringLiteralNode>(start, ident, end);
 	}
 
 	if (check(Kind::HEX_LITERAL)) {
 		auto ident = consume(Kind::HEX_LITERAL);
-		return new HexLiteralNode(ident);
+		return arena->make<HexLiteralNode>(ident);
 	}
 
 	if (check(Kind::DIGIT_LITERAL)) {
 		auto ident = consume(Kind::DIGIT_LITERAL);
-		return new DigitLiteralNode(ident);
+		return arena->make<DigitLiteralNode>(ident);
 	}
 
 	if (check(Kind::OCTAL_LITERAL)) {
 		auto ident = consume(Kind::OCTAL_LITERAL);
-		return new OctalLiteralNode(ident);
+		return arena->make<OctalLiteralNode>(ident);
 	}
 
 	if (check(Kind::BINARY_LITERAL)) {
 		auto ident = consume(Kind::BINARY_LITERAL);
-		return new BinaryLiteralNode(ident);
+		return arena->make<BinaryLiteralNode>(ident);
+	}
+
+	if (check(Kind::FLOAT_LITERAL)) {
+		auto ident = consume(Kind::FLOAT_LITERAL);
+		return arena->make<FloatLiteralNode>(ident);
 	}
 
-	parse_error(fmt::format("Unable to lex literal got {} instead!", peek()->to_string()));
+	parse_error(fmt::format("Unable to lex literal got {} instead!", describe(token())));
 	return nullptr;
 }
 
@@ -141,307 +168,200 @@ auto Parse::directive() -> Node* {
 	auto lit   = literal();
 	std::vector<Token*> nodes;
 
-	while (!check(Kind::EOL)) {
-		nodes.push_back(peek());
-		advance();
+	// Note: Directives keep their blanks so they print back the way they were written
+	for(;;) {
+		if (check(Kind::_EOF)) break;
+		if (trivia() != Trivia::NONE) nodes.push_back(blank_token());
+		if (check(Kind::EOL)) break;
+		nodes.push_back(take());
 	}
 
-	return new DirectiveNode(ident, lit, nodes);
+	return arena->make<DirectiveNode>(ident, lit, std::move(nodes));
 }
 
 auto Parse::reg() -> Node* {
-	if (!peek()->is_register()) parse_error(fmt::format("Expexted a register got {} instead", peek()->to_string()));
+	if (!is_register(kind())) parse_error(fmt::format("Expexted a register got {} instead", describe(token())));
 
 	if (check(Kind::REGISTER)) return v_register();
 	if (check(Kind::DATA)) return d_register();
 
-	parse_error(fmt::format("Impossed parse for register for token {}.", peek()->to_string()));
+	parse_error(fmt::format("Impossed parse for register for token {}.", describe(token())));
 	return nullptr;
 }
 
 auto Parse::v_register() -> Node* {
-	auto reg = consume(Kind::REGISTER);
-	auto str = reg->name;
-	auto id_str = str.substr(1);
-	size id = std::stoi(id_str);
+	size id = register_id(Kind::REGISTER);
 
-	return new VirtualRegisterNode(reg, id);
+	if (id >= REGISTER_CACHE) return lex->ctx->registers.virtual_register(id);
+	if (!virtuals[id]) virtuals[id] = lex->ctx->registers.virtual_register(id);
+	return virtuals[id];
 }
 
 auto Parse::d_register() -> Node* {
-	auto reg = consume(Kind::DATA);
+	size id = register_id(Kind::DATA);
+
+	if (id >= REGISTER_CACHE) return lex->ctx->registers.data_register(id);
+	if (!datas[id]) datas[id] = lex->ctx->registers.data_register(id);
+	return datas[id];
+}
 
-	auto str = reg->name;
-	auto id_str = str.substr(1);
-	size id = std::stoi(id_str);
+// Consumes a register token of kind and returns the number the lexer decoded after its r or d
+auto Parse::register_id(Kind kind) -> size {
+	auto n = at(1);
+	skip(kind);
 
-	return new DataRegisterNode(reg, id);
+	if (tokens.length(n) < 2) parse_error(fmt::format("Register '{}' has no number", lex->name(tokens, n)));
+	return tokens.value(n);
 }
 
 auto Parse::type() -> Node* {
-	auto ident = peek();
-	if (!ident->is_type()) parse_error(fmt::format("Token is not type {}", ident->to_string()));
-	advance();
+	if (!is_type(kind())) parse_error(fmt::format("Token is not type {}", describe(token())));
+	auto ident = take();
 
-	if (ident->kind == Kind::I8) return new TypeNode(ident, NodeKinds::I8_TYPE_NODE);
-	if (ident->kind == Kind::I16) return new TypeNode(ident, NodeKinds::I16_TYPE_NODE);
-	if (ident->kind == Kind::I32) return new TypeNode(ident, NodeKinds::I32_TYPE_NODE);
-	if (ident->kind == Kind::I64) return new TypeNode(ident, NodeKinds::I64_TYPE_NODE);
+	if (ident->kind == Kind::I8) return arena->make<TypeNode>(ident, NodeKinds::I8_TYPE_NODE);
+	if (ident->kind == Kind::I16) return arena->make<TypeNode>(ident, NodeKinds::I16_TYPE_NODE);
+	if (ident->kind == Kind::I32) return arena->make<TypeNode>(ident, NodeKinds::I32_TYPE_NODE);
+	if (ident->kind == Kind::I64) return arena->make<TypeNode>(ident, NodeKinds::I64_TYPE_NODE);
 
-	parse_error(fmt::format("Impossible token error for looking for type got {} instead.", ident->to_string()));
+	parse_error(fmt::format("Impossible token error for looking for type got {} instead.", describe(*ident)));
 	return nullptr;
 }
 
 auto Parse::data() -> Node* {
-	if (check(3, Kind::OPEN_BRACE)) return data_types();
-	if (check(3, Kind::STATIC)) return data_static();
+	// d10 SPACE { in TEXT mode, the blank is trivia on the { otherwise
+	i8 n = trivia_free ? 2 : 3;
 
-	fmt::println("Data node must either be a static node ex (d10 STATIC literal) or a type node ex(d10 {{i32 i32 i8}})");
+	if (check(n, Kind::OPEN_BRACE)) return data_types();
+	if (check(n, Kind::STATIC)) return data_static();
 
-	parse_error(fmt::format("Illegal token found for data node definition {}", peek()->to_string()));
+	parse_error(fmt::format("Illegal token found for data node definition {}, a data node must either be a static node ex (d10 STATIC literal) or a type node ex(d10 {{i32 i32 i8}})", describe(token())));
 	return nullptr;
 }
 
 auto Parse::data_types() -> Node* {
 	auto reg = d_register();
-	consume(Kind::SPACE);
+	space();
 
 	auto open = consume(Kind::OPEN_BRACE);
 	std::vector<Node*> nodes;
 	for(;;) {
-		consume(Kind::SPACE);
+		space();
 		if (check(Kind::CLOSE_BRACE)) break;
 
 		auto type = this->type();
 		nodes.push_back(type);
 	}
 	auto end = consume(Kind::CLOSE_BRACE);
-	return new DataTypeNode(reg, open, nodes, end);
+	return arena->make<DataTypeNode>(reg, open, std::move(nodes), end);
 }
 
 auto Parse::data_static() -> Node*{
 	auto reg = d_register();
-	consume(Kind::SPACE);
+	space();
 	auto ident = consume(Kind::STATIC);
-	consume(Kind::SPACE);
+	space();
 	auto lit = literal();
-	return new DataStaticNode(reg, ident, lit);
+	return arena->make<DataStaticNode>(reg, ident, lit);
 }
 
-/**
- * Parse out all the bi nodes
- * ADD
- * SUBTRACT
- * DIVIDE
- * MULTIPLY
- * AND
- * OR
- * XOR
- */
-auto Parse::bi_node() -> Node* {
-	auto ident = peek();
-	if (!ident->is_bi_instruction()) parse_error(fmt::format("Expected a Bi instruction got {} instead", ident->to_string()));
-
-	advance();
-	consume(Kind::SPACE);
-	auto in_1 = reg();
-	consume(Kind::COMMA);
-	consume(Kind::SPACE);
-	auto in_2 = reg();
-	consume(Kind::SPACE);
-	consume(Kind::RIGHT_ARROW);
-	consume(Kind::SPACE);
-	auto out = v_register();
-	if (ident->kind == Kind::ADD) return new BiNode(ident, in_1, in_2, out, NodeKinds::ADD_NODE);
-	if (ident->kind == Kind::SUBTRACT) return new BiNode(ident, in_1, in_2, out, NodeKinds::SUB_NODE);
-	if (ident->kind == Kind::DIVIDE) return new BiNode(ident, in_1, in_2, out, NodeKinds::DIV_NODE);
-	if (ident->kind == Kind::MULTIPLY) return new BiNode(ident, in_1, in_2, out, NodeKinds::MUL_NODE);
-	if (ident->kind == Kind::AND) return new BiNode(ident, in_1, in_2, out, NodeKinds::AND_NODE);
-	if (ident->kind == Kind::OR) return new BiNode(ident, in_1, in_2, out, NodeKinds::OR_NODE);
-	if (ident->kind == Kind::XOR) return new BiNode(ident, in_1, in_2, out, NodeKinds::XOR_NODE);
-
-	parse_error(fmt::format("Impossible parse for binary instruction got {}.", ident->to_string()));
-
-	return nullptr;
-}
+auto Parse::advance(i8 n) -> void { idx = idx + n; }
+auto Parse::advance() -> void { advance(1); }
 
 /**
- * Parse out the comparioson nodes
- *
- * COMPARE_GREATER_THAN
- * COMPARE_EQUALITY
- * COMPARE_LESS_THAN
+ * Absolute index of the token n ahead. The lexer fills the buffer in runs of
+ * half its size so lexing and parsing each stay hot for a while, slots the
+ * parser has moved past get reused.
  */
-auto Parse::compare() -> Node* {
-	auto ident = peek();
-	if (!ident->is_compare()) parse_error(fmt::format("{{}} \n\t is not a comparioson node", ident->name));
-
-	consume(Kind::SPACE);
-	auto in_1 = reg();
-	consume(Kind::COMMA);
-	consume(Kind::SPACE);
-	auto in_2 = reg();
-
-	if (ident->kind == Kind::COMPARE_EQUALITY) return new CompareNode(ident, in_1, in_2, NodeKinds::COMPARE_EQUALITY_NODE);
-	if (ident->kind == Kind::COMPARE_GREATER_THAN) return new CompareNode(ident, in_1, in_2, NodeKinds::COMPARE_GREATER_THAN_NODE);
-	if (ident->kind == Kind::COMPARE_LESS_THAN) return new CompareNode(ident, in_1, in_2, NodeKinds::COMPARE_LESS_THAN_NODE);
+auto Parse::at(i8 n) -> size {
+	size pos = idx + n;
 
-	parse_error(fmt::format("Impossible token found for comparision identifer -> {}", ident->to_string()));
-	return nullptr;
-}
+	if (tokens.count <= pos) {
+		size until = idx + TokenBuffer::CAPACITY / 2;
 
-/**
- * JUMP
- * JUMP_EQUAL
- * JUMP_IF
- * JUMP_NOT_EQUAL
- */
-auto Parse::jump() -> Node* {
-	auto ident = peek();
-	if (!ident->is_jump()) parse_error(fmt::format("{{}} \n\t is not a jump node", ident->name));
-
-	consume(Kind::SPACE);
-	auto in_1 = reg();
-	consume(Kind::COMMA);
-	consume(Kind::SPACE);
-	auto in_2 = reg();
-
-	if (ident->kind == Kind::JUMP) return new JumpNode(ident, in_1, in_2, NodeKinds::JUMP_NODE);
-	if (ident->kind == Kind::JUMP_EQUAL) return new JumpNode(ident, in_1, in_2, NodeKinds::JUMP_EQUAL_NODE);
-	if (ident->kind == Kind::JUMP_IF) return new JumpNode(ident, in_1, in_2, NodeKinds::JUMP_IF_NODE);
-	if (ident->kind == Kind::JUMP_NOT_EQUAL) return new JumpNode(ident, in_1, in_2, NodeKinds::JUMP_NOT_EQUAL_NODE);
-
-	parse_error(fmt::format("Impossible token found for comparision identifer -> {}", ident->to_string()));
-	return nullptr;
+		// Note: next() can append three tokens at once so stop short of the slot at idx
+		while (tokens.count <= pos || (tokens.count < until && tokens.kind(tokens.count - 1) != Kind::_EOF)) {
+			lex->next(tokens);
+		}
+	}
+	return pos;
 }
 
-auto Parse::_not() -> Node* {
-	auto ident = consume(Kind::NOT);
-	consume(Kind::SPACE);
-
-	auto in = reg();
+auto Parse::kind(i8 n) -> Kind { return tokens.kind(at(n)); }
+auto Parse::kind() -> Kind { return kind(1); }
 
-	consume(Kind::SPACE);
-	consume(Kind::RIGHT_ARROW);
-	consume(Kind::SPACE);
+auto Parse::trivia() -> Trivia { return tokens.blank(at(1)); }
 
-	auto out = reg();
+auto Parse::token(i8 n) -> Token { return lex->token(tokens, at(n)); }
+auto Parse::token() -> Token { return token(1); }
 
-	return new NotNode(ident, in, out);
-}
-
-auto Parse::_return() -> Node* {
-	DebugInfo("Start parse of return node")
-	auto ident = consume(Kind::RETURN);
+auto Parse::check(i8 n, Kind kind) -> bool { return kind == this->kind(n); }
+auto Parse::check(Kind kind) -> bool { return check(1, kind); }
 
-	consume(Kind::SPACE);
-	auto target = reg();
+auto Parse::consume(Kind kind) -> Token* {
+	if (!check(kind)) parse_error(fmt::format("Expected kind of {} got {}  for token {}",name_from_kind(kind), name_from_kind(this->kind()), describe(token())));
 
-	DebugInfo("End parse of return node")
-	return new ReturnNode(ident, target);
+	return take();
 }
 
-auto Parse::de_ref() -> Node* {
-	auto ident = consume(Kind::DEREF);
-
-	consume(Kind::SPACE);
-
-	auto in = reg();
-
-	consume(Kind::SPACE);
-	consume(Kind::RIGHT_ARROW);
-	consume(Kind::SPACE);
-
-	auto out = reg();
+// Like consume but for tokens no node keeps, so nothing is copied out of the ring
+auto Parse::skip(Kind kind) -> void {
+	if (!check(kind)) parse_error(fmt::format("Expected kind of {} got {}  for token {}",name_from_kind(kind), name_from_kind(this->kind()), describe(token())));
+	if (trivia() != Trivia::NONE) parse_error(fmt::format("Unexpected whitespace before {}", describe(token())));
 
-	return new DerefNode(ident, in, out);
+	advance();
 }
 
-auto Parse::ptr_to() -> Node* {
-	auto ident = consume(Kind::POINTERTO);
-
-	consume(Kind::SPACE);
-	auto in = reg();
-	consume(Kind::SPACE);
-	auto out = reg();
+// Copies the next token out of the ring into the arena so a node can hold on to it
+auto Parse::take() -> Token* {
+	if (trivia() != Trivia::NONE) parse_error(fmt::format("Unexpected whitespace before {}", describe(token())));
 
-	return new PointerToNode(ident, in, out);
+	auto ident = arena->make<Token>(token());
+	advance();
+	return ident;
 }
 
-auto Parse::call() -> Node* {
-	auto ident = consume(Kind::CALL);
-
-	consume(Kind::SPACE);
-	auto lib = literal();
-	consume(Kind::DOT);
-	auto func = literal();
-
-	std::vector<Node*> params;
-
-	for(;;) {
-		if (check(Kind::EOL)) break;
-		consume(Kind::SPACE);
-		params.push_back(reg());
-	}
+/**
+ * Layout checks, in TEXT mode the blank is its own token and gets consumed.
+ * In TRIVIA_FREE mode the next token has to carry a run of exactly that one
+ * blank, which is then cleared so skip() and take() know it was expected.
+ */
+auto Parse::is_blank(Trivia kind) -> bool {
+	if (!trivia_free) return check(kind == Trivia::TAB ? Kind::TAB : Kind::SPACE);
 
-	return new CallNode(ident, lib, func, params);
+	return trivia() == kind;
 }
 
-auto Parse::store() -> Node* {
-	auto ident = consume(Kind::STORE);
-
-	consume(Kind::SPACE);
-
-	auto value = reg();
+auto Parse::blank(Trivia kind) -> void {
+	if (!trivia_free) return skip(kind == Trivia::TAB ? Kind::TAB : Kind::SPACE);
 
-	consume(Kind::SPACE);
-	consume(Kind::RIGHT_ARROW);
-	consume(Kind::SPACE);
-
-	auto out = reg();
-	return new StoreNode(ident, value, out);
+	if (trivia() != kind || tokens.width(at(1)) != 1) parse_error(fmt::format("Expected a single {} before {}", kind == Trivia::TAB ? "tab" : "space", describe(token())));
+	tokens.clear_blank(at(1));
 }
 
-auto Parse::write() -> Node* {
-	auto ident = consume(Kind::WRITE);
-
-	consume(Kind::SPACE);
-
-	auto value = reg();
-
-	consume(Kind::SPACE);
-	consume(Kind::RIGHT_ARROW);
-	consume(Kind::SPACE);
+// The blank run in front of the next token as a SPACE/TAB token, the same one TEXT mode would have made
+auto Parse::blank_token() -> Token* {
+	auto next  = token();
+	auto width = tokens.width(at(1));
+	auto kind  = trivia() == Trivia::TAB ? Kind::TAB : Kind::SPACE;
 
-	auto out = reg();
-	return new WriteNode(ident, value, out);
+	tokens.clear_blank(at(1));
+	return arena->make<Token>(std::string_view(next.name.data() - width, width), kind, Pos(next.pos.file, next.pos.offset - width, width));
 }
 
-auto Parse::advance(i8 n) -> void { idx = idx + n; }
-auto Parse::advance() -> void { advance(1); }
-
-auto Parse::peek(i8 n) -> Token* {return lex->tokens.at(idx + n);}
-auto Parse::peek() -> Token* { return peek(1); }
-
-auto Parse::check(i8 n, Kind kind) -> bool { return kind == peek(n)->kind; }
-auto Parse::check(Kind kind) -> bool { return check(1, kind); }
+auto Parse::space() -> void { blank(Trivia::SPACE); }
+auto Parse::tab() -> void { blank(Trivia::TAB); }
 
-auto Parse::consume(Kind kind) -> Token* {
-	if (!check(kind)) parse_error(fmt::format("Expected kind of {} got {}  for token {}",name_from_kind(kind), name_from_kind(peek()->kind), peek()->to_string()));
-
-	auto ident = peek();
-	advance();
-	return ident;
+// A token for an error message, this is where its line and column get looked up
+auto Parse::describe(Token token) -> std::string {
+	return token.to_string(lex->ctx->sources);
 }
 
 auto Parse::not_impl(std::string msg) -> void {
-	fmt::println("Not implemented: {}", msg);
-	std::exit(Error::NOT_IMPLEMENTED);
+	compile_error(ErrorCode::NOT_IMPLEMENTED, fmt::format("Not implemented: {}", msg));
 }
 
 auto Parse::parse_error(std::string msg) -> void {
-	fmt::println("Parse Error: {}", msg);
-	std::exit(ErrorCode::PARSE_ERROR);
+	compile_error(ErrorCode::PARSE_ERROR, fmt::format("Parse Error: {}", msg));
 }
 
 }
@@ -0,0 +1,177 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <parse/Scan.hh>
+
+#if defined(__x86_64__)
+#define SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace hive::ir {
+
+static auto is_ident_byte(char c) -> bool {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static auto scalar_ident_end(const char* ptr) -> const char* {
+	while (is_ident_byte(*ptr)) ptr++;
+	return ptr;
+}
+
+static auto scalar_quote_end(const char* ptr) -> const char* {
+	while (*ptr != '"' && *ptr != '\0') ptr++;
+	return ptr;
+}
+
+static auto scalar_blank_end(const char* ptr) -> const char* {
+	while (*ptr == ' ' || *ptr == '\t') ptr++;
+	return ptr;
+}
+
+static auto scalar_line_starts(const char* ptr, size length, std::vector<u32>& lines) -> void {
+	for (size i = 0; i < length; i++) {
+		if (ptr[i] == '\n') lines.push_back(i + 1);
+	}
+}
+
+// Pushes the offset after every set bit of a newline mask for the block at base
+static auto push_lines(u32 mask, size base, std::vector<u32>& lines) -> void {
+	while (mask) {
+		lines.push_back(base + __builtin_ctz(mask) + 1);
+		mask &= mask - 1;
+	}
+}
+
+#ifdef SCAN_X86
+
+// Note: Signed compares are fine here, anything >= 0x80 is negative and lands outside every range
+static auto sse2_ident_mask(__m128i bytes) -> u32 {
+	auto lower = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+	auto alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+	auto digit = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(bytes, _mm_set1_epi8('9' + 1)));
+	auto under = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('_'));
+	return (u32)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(alpha, digit), under));
+}
+
+static auto sse2_ident_end(const char* ptr) -> const char* {
+	for (;; ptr += 16) {
+		u32 stop = ~sse2_ident_mask(_mm_loadu_si128((const __m128i*)ptr)) & 0xFFFF;
+		if (stop) return ptr + __builtin_ctz(stop);
+	}
+}
+
+static auto sse2_quote_end(const char* ptr) -> const char* {
+	for (;; ptr += 16) {
+		auto bytes = _mm_loadu_si128((const __m128i*)ptr);
+		auto hit   = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')), _mm_cmpeq_epi8(bytes, _mm_setzero_si128()));
+		u32 stop   = (u32)_mm_movemask_epi8(hit);
+		if (stop) return ptr + __builtin_ctz(stop);
+	}
+}
+
+static auto sse2_blank_end(const char* ptr) -> const char* {
+	for (;; ptr += 16) {
+		auto bytes = _mm_loadu_si128((const __m128i*)ptr);
+		auto blank = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t')));
+		u32 stop   = ~(u32)_mm_movemask_epi8(blank) & 0xFFFF;
+		if (stop) return ptr + __builtin_ctz(stop);
+	}
+}
+
+static auto sse2_line_starts(const char* ptr, size length, std::vector<u32>& lines) -> void {
+	for (size i = 0; i < length; i += 16) {
+		auto bytes = _mm_loadu_si128((const __m128i*)(ptr + i));
+		u32 mask   = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+
+		// Note: The last block reads into the padding, drop anything past length
+		if (length - i < 16) mask &= (1u << (length - i)) - 1;
+		push_lines(mask, i, lines);
+	}
+}
+
+__attribute__((target("avx2")))
+static auto avx2_ident_end(const char* ptr) -> const char* {
+	for (;; ptr += 32) {
+		auto bytes = _mm256_loadu_si256((const __m256i*)ptr);
+		auto lower = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20));
+		auto alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+		auto digit = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), bytes));
+		auto under = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('_'));
+		u32 stop   = ~(u32)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(alpha, digit), under));
+		if (stop) return ptr + __builtin_ctz(stop);
+	}
+}
+
+__attribute__((target("avx2")))
+static auto avx2_quote_end(const char* ptr) -> const char* {
+	for (;; ptr += 32) {
+		auto bytes = _mm256_loadu_si256((const __m256i*)ptr);
+		auto hit   = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(bytes, _mm256_setzero_si256()));
+		u32 stop   = (u32)_mm256_movemask_epi8(hit);
+		if (stop) return ptr + __builtin_ctz(stop);
+	}
+}
+
+__attribute__((target("avx2")))
+static auto avx2_blank_end(const char* ptr) -> const char* {
+	for (;; ptr += 32) {
+		auto bytes = _mm256_loadu_si256((const __m256i*)ptr);
+		auto blank = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t')));
+		u32 stop   = ~(u32)_mm256_movemask_epi8(blank);
+		if (stop) return ptr + __builtin_ctz(stop);
+	}
+}
+
+__attribute__((target("avx2")))
+static auto avx2_line_starts(const char* ptr, size length, std::vector<u32>& lines) -> void {
+	for (size i = 0; i < length; i += 32) {
+		auto bytes = _mm256_loadu_si256((const __m256i*)(ptr + i));
+		u32 mask   = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')));
+
+		if (length - i < 32) mask &= (1u << (length - i)) - 1;
+		push_lines(mask, i, lines);
+	}
+}
+
+#endif
+
+static const ScanKernels scalar_kernels = { ScanLevel::SCALAR, "scalar", scalar_ident_end, scalar_quote_end, scalar_blank_end, scalar_line_starts };
+
+#ifdef SCAN_X86
+static const ScanKernels sse2_kernels = { ScanLevel::SSE2, "sse2", sse2_ident_end, sse2_quote_end, sse2_blank_end, sse2_line_starts };
+static const ScanKernels avx2_kernels = { ScanLevel::AVX2, "avx2", avx2_ident_end, avx2_quote_end, avx2_blank_end, avx2_line_starts };
+#endif
+
+static auto supported_level() -> ScanLevel {
+#ifdef SCAN_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) return ScanLevel::AVX2;
+	return ScanLevel::SSE2;
+#else
+	return ScanLevel::SCALAR;
+#endif
+}
+
+auto scan_kernels(ScanLevel level) -> const ScanKernels& {
+	static const ScanLevel best = supported_level();
+
+	if (level > best) level = best;
+
+	switch (level) {
+#ifdef SCAN_X86
+		case ScanLevel::AVX2: return avx2_kernels;
+		case ScanLevel::SSE2: return sse2_kernels;
+#endif
+		default: return scalar_kernels;
+	}
+}
+
+auto scan_kernels() -> const ScanKernels& {
+	return scan_kernels(ScanLevel::AVX2);
+}
+
+}
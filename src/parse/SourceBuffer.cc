@@ -0,0 +1,160 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <parse/SourceBuffer.hh>
+
+#include <fmt/core.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(OS_WINDOWS)
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace hive::ir {
+
+SourceBuffer::~SourceBuffer() {
+	unload();
+}
+
+auto SourceBuffer::load(const char* path) -> bool {
+	unload();
+
+	if (std::strcmp(path, "-") == 0) {
+		return read_stream(0, path);
+	}
+
+	int fd = ::open(path, O_RDONLY);
+	if (fd < 0) {
+		error = fmt::format("No file {} found", path);
+		return false;
+	}
+
+	struct stat info;
+	bool is_file = fstat(fd, &info) == 0 && S_ISREG(info.st_mode);
+	bool ok;
+
+	if (is_file && (size)info.st_size > MAX_LENGTH) {
+		ok    = false;
+		error = too_long(path);
+	} else if (is_file && info.st_size > 0) {
+		ok = map_file(fd, info.st_size, path);
+	} else {
+		ok = read_stream(fd, path);
+	}
+
+	::close(fd);
+
+	if (!ok && error.empty()) {
+		error = fmt::format("Failed to read {}", path);
+	}
+	return ok;
+}
+
+auto SourceBuffer::map_file(int fd, size file_size, const char* path) -> bool {
+#if defined(OS_WINDOWS)
+	return read_stream(fd, path);
+#else
+	size page = (size)sysconf(_SC_PAGESIZE);
+	size span = (file_size + PADDING + page - 1) / page * page;
+
+	// Note: Reserve zeroed pages first and map the file over the front of them,
+	//       whatever is left of the reservation is the zero padding after the file
+	auto base = (char*)mmap(nullptr, span, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (base == MAP_FAILED) {
+		return read_stream(fd, path);
+	}
+
+	auto file = mmap(base, file_size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+	if (file == MAP_FAILED) {
+		munmap(base, span);
+		return read_stream(fd, path);
+	}
+
+	madvise(base, file_size, MADV_SEQUENTIAL);
+
+	bytes    = base;
+	len      = file_size;
+	capacity = span;
+	mapped   = true;
+	return true;
+#endif
+}
+
+auto SourceBuffer::read_stream(int fd, const char* path) -> bool {
+	for (;;) {
+		if (len + READ_CHUNK + PADDING > capacity) {
+			size grown = capacity ? capacity * 2 : READ_CHUNK + PADDING;
+			auto next  = (char*)std::realloc(bytes, grown);
+
+			if (!next) {
+				error = "Unable to allocate memory for source buffer";
+				return false;
+			}
+			bytes    = next;
+			capacity = grown;
+		}
+
+		auto got = ::read(fd, bytes + len, READ_CHUNK);
+
+		if (got < 0 && errno == EINTR) continue;
+		if (got < 0) return false;
+		if (got == 0) break;
+
+		len += got;
+
+		if (len > MAX_LENGTH) {
+			error = too_long(path);
+			return false;
+		}
+	}
+
+	if (!bytes) {
+		bytes    = (char*)std::malloc(PADDING);
+		capacity = PADDING;
+	}
+
+	std::memset(bytes + len, 0, PADDING);
+	mapped = false;
+	return true;
+}
+
+auto SourceBuffer::too_long(const char* path) -> std::string {
+	return fmt::format("{} is 4 GiB or larger, a source can be at most {} bytes", path, MAX_LENGTH);
+}
+
+auto SourceBuffer::unload() -> void {
+	if (!bytes) return;
+
+#if !defined(OS_WINDOWS)
+	if (mapped) {
+		munmap(bytes, capacity);
+	} else {
+		std::free(bytes);
+	}
+#else
+	std::free(bytes);
+#endif
+
+	bytes    = nullptr;
+	len      = 0;
+	capacity = 0;
+	mapped   = false;
+}
+
+auto SourceBuffer::data() const -> const char* { return bytes; }
+auto SourceBuffer::length() const -> size { return len; }
+auto SourceBuffer::is_mapped() const -> bool { return mapped; }
+
+}
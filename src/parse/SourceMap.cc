@@ -0,0 +1,49 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <parse/SourceMap.hh>
+
+#include <parse/Scan.hh>
+
+#include <algorithm>
+
+namespace hive::ir {
+
+auto SourceMap::add(std::string_view path) -> FileId {
+	auto& file = files.emplace_back();
+	file.path = path;
+	return (FileId)(files.size() - 1);
+}
+
+auto SourceMap::clear() -> void {
+	files.clear();
+}
+
+auto SourceMap::path(FileId file) const -> std::string_view {
+	return files.at(file).path;
+}
+
+auto SourceMap::file(FileId file) -> SourceFile& {
+	return files.at(file);
+}
+
+auto SourceMap::location(FileId file, u32 offset) -> Location {
+	auto& lines = line_table(files.at(file));
+
+	// last line starting at or before offset
+	auto line = std::upper_bound(lines.begin(), lines.end(), offset) - 1;
+	return Location{(u32)(line - lines.begin() + 1), offset - *line + 1};
+}
+
+auto SourceMap::line_table(SourceFile& source) -> const std::vector<u32>& {
+	std::call_once(source.lines_once, [&source] {
+		source.lines.push_back(0);
+		scan_kernels().line_starts(source.buffer.data(), source.buffer.length(), source.lines);
+	});
+	return source.lines;
+}
+
+}
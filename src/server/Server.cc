@@ -0,0 +1,239 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <server/Server.hh>
+#include <util/ThreadPool.hh>
+
+#include <fmt/format.h>
+
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace hive::ir {
+
+static auto read_all(int fd, void* data, size length) -> bool {
+	auto ptr = (char*)data;
+
+	while (length > 0) {
+		auto got = ::read(fd, ptr, length);
+		if (got < 0 && errno == EINTR) continue;
+		if (got <= 0) return false;
+
+		ptr += got;
+		length -= got;
+	}
+	return true;
+}
+
+static auto write_all(int fd, const void* data, size length) -> bool {
+	auto ptr = (const char*)data;
+
+	while (length > 0) {
+		auto put = ::send(fd, ptr, length, MSG_NOSIGNAL);
+		if (put < 0 && errno == EINTR) continue;
+		if (put <= 0) return false;
+
+		ptr += put;
+		length -= put;
+	}
+	return true;
+}
+
+static auto socket_address(const std::string& path, sockaddr_un& address) -> bool {
+	if (path.size() >= sizeof(address.sun_path)) return false;
+
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	std::memcpy(address.sun_path, path.data(), path.size());
+	return true;
+}
+
+Server::Server(std::string path, size workers) : path(std::move(path)), workers(workers) {
+	if (this->workers == 0) {
+		this->workers = ThreadPool::hardware_threads();
+	}
+}
+
+Server::~Server() {
+	if (listener >= 0) {
+		::close(listener);
+		::unlink(path.c_str());
+	}
+}
+
+auto Server::run() -> std::optional<Diagnostic> {
+	try {
+		listen();
+	} catch (const CompileError& error) {
+		return error.diagnostic;
+	}
+
+	std::vector<std::thread> threads;
+	for (size i = 1; i < workers; i++) {
+		threads.emplace_back([this] { work(); });
+	}
+	work();
+
+	For(threads) it.join();
+	return std::nullopt;
+}
+
+auto Server::listen() -> void {
+	sockaddr_un address;
+
+	if (!socket_address(path, address)) {
+		compile_error(ErrorCode::IO_ERROR, fmt::format("Socket path {} is too long", path));
+	}
+
+	// only ever replace a socket, anything else at path is somebody's file
+	struct stat info;
+	if (::lstat(path.c_str(), &info) == 0) {
+		if (!S_ISSOCK(info.st_mode)) {
+			compile_error(ErrorCode::IO_ERROR, fmt::format("{} exists and is not a socket", path));
+		}
+
+		int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (probe < 0) {
+			compile_error(ErrorCode::IO_ERROR, fmt::format("Unable to create a socket: {}", std::strerror(errno)));
+		}
+
+		bool live = ::connect(probe, (sockaddr*)&address, sizeof(address)) == 0;
+		::close(probe);
+
+		if (live) {
+			compile_error(ErrorCode::IO_ERROR, fmt::format("A server is already listening on {}", path));
+		}
+
+		// nobody answers on it, so it was left over from a server that died
+		::unlink(path.c_str());
+	}
+
+	int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+	if (fd < 0 || ::bind(fd, (sockaddr*)&address, sizeof(address)) != 0 || ::listen(fd, SOMAXCONN) != 0) {
+		auto message = fmt::format("Unable to listen on {}: {}", path, std::strerror(errno));
+		if (fd >= 0) ::close(fd);
+		compile_error(ErrorCode::IO_ERROR, message);
+	}
+
+	// Note: set last, the destructor only removes the socket once this process made it
+	listener = fd;
+}
+
+auto Server::stop() -> void {
+	stopping = true;
+
+	// wakes every worker blocked in accept()
+	if (listener >= 0) ::shutdown(listener, SHUT_RDWR);
+}
+
+auto Server::work() -> void {
+	Compiler compiler(CompileOptions{1});
+
+	while (!stopping) {
+		int connection = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+
+		if (connection < 0) {
+			if (errno == EINTR || errno == ECONNABORTED) continue;
+			break;
+		}
+
+		timeval timeout = {IO_TIMEOUT_SECONDS, 0};
+		::setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+		::setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+		serve(compiler, connection);
+		::close(connection);
+	}
+}
+
+auto Server::serve(Compiler& compiler, int connection) -> void {
+	u32 length;
+	if (!read_all(connection, &length, sizeof(length)) || length == 0 || length > MAX_REQUEST_BYTES) return;
+
+	std::string request(length, '\0');
+	if (!read_all(connection, request.data(), length) || request.back() != '\0') return;
+
+	// cwd first, then the arguments, each NUL terminated
+	auto cwd = request.c_str();
+	std::vector<const char*> args;
+
+	for (size at = std::strlen(cwd) + 1; at < request.size(); at += std::strlen(request.c_str() + at) + 1) {
+		args.push_back(request.c_str() + at);
+	}
+
+	std::string out;
+	i32 code = run_cli(compiler, args, CliEnv{cwd, 1}, out);
+
+	u32 out_length = out.size();
+	write_all(connection, &code, sizeof(code)) && write_all(connection, &out_length, sizeof(out_length)) && write_all(connection, out.data(), out.size());
+}
+
+auto forward(const char* path, std::span<const char* const> args, std::string& out) -> int {
+	sockaddr_un address;
+
+	if (!socket_address(path, address)) {
+		out = fmt::format("Socket path {} is too long\n", path);
+		return ErrorCode::IO_ERROR;
+	}
+
+	char cwd[4096];
+	if (!::getcwd(cwd, sizeof(cwd))) {
+		out = fmt::format("Unable to get the working directory: {}\n", std::strerror(errno));
+		return ErrorCode::IO_ERROR;
+	}
+
+	std::string request;
+	request.append(cwd).push_back('\0');
+
+	For(args) {
+		request.append(it).push_back('\0');
+	}
+
+	if (request.size() > Server::MAX_REQUEST_BYTES) {
+		out = "Command line is too long for the compile server\n";
+		return ErrorCode::IO_ERROR;
+	}
+
+	int connection = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+	if (connection < 0 || ::connect(connection, (sockaddr*)&address, sizeof(address)) != 0) {
+		out = fmt::format("Unable to connect to {}: {}\n", path, std::strerror(errno));
+		if (connection >= 0) ::close(connection);
+		return ErrorCode::IO_ERROR;
+	}
+
+	u32 length = request.size();
+	i32 code = ErrorCode::IO_ERROR;
+	u32 out_length = 0;
+
+	bool ok = write_all(connection, &length, sizeof(length))
+		&& write_all(connection, request.data(), request.size())
+		&& read_all(connection, &code, sizeof(code))
+		&& read_all(connection, &out_length, sizeof(out_length));
+
+	if (ok) {
+		out.resize(out_length);
+		ok = read_all(connection, out.data(), out_length);
+	}
+	::close(connection);
+
+	if (!ok) {
+		out = fmt::format("Lost the connection to {}\n", path);
+		return ErrorCode::IO_ERROR;
+	}
+	return code;
+}
+
+}
@@ -7,41 +7,66 @@
 #include <token/Token.hh>
 #include <fmt/core.h>
 
+#include <charconv>
+
 namespace hive::ir {
 
-Pos::Pos(std::string path, size offset_start, size line, size column, size offset_end) {
-	this->path = path;
-	this->offset_start = offset_start;
-	this->line = line;
-	this->column = column;
-	this->offset_end = offset_end;
-	this->len = this->offset_end - this->offset_start;
+Pos::Pos(FileId file, size offset, size len) {
+	this->file   = file;
+	this->offset = offset;
+	this->len    = len;
+}
+
+auto Pos::to_string(SourceMap& sources) -> std::string {
+	auto where = sources.location(file, offset);
+	return fmt::format("Pos{{file={}, offset={}, line={}, column={}, len={}}}", sources.path(file), offset, where.line, where.column, len);
 }
 
-auto Pos::to_string() -> std::string {
-	return fmt::format("Pos{{path={}, offset_start={}, line={}, column={}, offset_end={}, len={}}}", path, offset_start, line, column, offset_end, len);
+auto decode_number(TokenKind kind, std::string_view text, TokenValue& value) -> std::errc {
+	auto begin = text.data();
+	auto end   = text.data() + text.size();
+	int base   = 10;
+
+	switch (kind) {
+		case TokenKind::HEX_LITERAL: base = 16; begin += 2; break;
+		case TokenKind::BINARY_LITERAL: base = 2; begin += 2; break;
+		case TokenKind::OCTAL_LITERAL: base = 8; begin += 2; break;
+		case TokenKind::REGISTER:
+		case TokenKind::DATA: begin += 1; break; // the r or d
+		case TokenKind::FLOAT_LITERAL: {
+			auto res = std::from_chars(begin, end, value.real);
+			if (res.ec == std::errc() && res.ptr != end) return std::errc::invalid_argument;
+			return res.ec;
+		}
+		default: break;
+	}
+
+	auto res = std::from_chars(begin, end, value.integer, base);
+	if (res.ec == std::errc() && res.ptr != end) return std::errc::invalid_argument;
+	return res.ec;
 }
 
-Token::Token(std::string name, Kind kind, Pos pos) : name(name), kind(kind), pos(pos) {}
+Token::Token(std::string_view name, Kind kind, Pos pos) : name(name), kind(kind), pos(pos) {}
 
-Token::Token(std::string name, Pos pos): name(name), kind(kind_from_name(name)), pos(pos) {}
+Token::Token(std::string_view name, Pos pos): name(name), kind(kind_from_name(name)), pos(pos) {}
 
-Token::Token(Kind kind, Pos pos) : kind(kind), name(name_from_kind(kind)), pos(pos) {}
+Token::Token(Kind kind, Pos pos) : name(name_from_kind(kind)), kind(kind), pos(pos) {}
 
-auto Token::is_literal() -> bool { return (Kind::LITERAL_START < kind && kind < Kind::LITERAL_END); }
-auto Token::is_type() -> bool { return (Kind::TYPE_START < kind && kind < Kind::TYPE_END); }
-auto Token::is_instruction() -> bool { return (Kind::INSTRUCTION_START < kind && kind < Kind::INSTRUCTION_END); }
-auto Token::is_bi_instruction() -> bool { return (Kind::BI_INSTRUCTION_START < kind && kind < Kind::BI_INSTRUCTION_END); }
-auto Token::is_register() -> bool { return (Kind::REISTER_START < kind && kind < Kind::REISTER_END); }
-auto Token::is_compare() -> bool { return (Kind::COMPARE_START < kind && kind < Kind::COMPARE_END); }
-auto Token::is_jump() -> bool { return (Kind::JUMP_START < kind && kind < Kind::JUMP_END); }
+auto Token::is_literal() -> bool { return ir::is_literal(kind); }
+auto Token::is_type() -> bool { return ir::is_type(kind); }
+auto Token::is_instruction() -> bool { return ir::is_instruction(kind); }
+auto Token::is_bi_instruction() -> bool { return ir::is_bi_instruction(kind); }
+auto Token::is_register() -> bool { return ir::is_register(kind); }
+auto Token::is_compare() -> bool { return ir::is_compare(kind); }
+auto Token::is_jump() -> bool { return ir::is_jump(kind); }
 
-auto Token::to_string() -> std::string {
-	return fmt::format("Token{{name={}, kind={}, {}}}", name, name_from_kind(kind), pos.to_string());
+auto Token::to_string(SourceMap& sources) -> std::string {
+	return fmt::format("Token{{name={}, kind={}, {}}}", name, name_from_kind(kind), pos.to_string(sources));
 }
 
-auto Token::short_to_string() -> std::string {
-	return fmt::format("[{} @ {}:{}]", name, pos.line, pos.column);
+auto Token::short_to_string(SourceMap& sources) -> std::string {
+	auto where = sources.location(pos.file, pos.offset);
+	return fmt::format("[{} @ {}:{}]", name, where.line, where.column);
 }
 
 }
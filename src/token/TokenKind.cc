@@ -8,26 +8,100 @@
 
 namespace hive::ir {
 
-const std::map<TokenKind, std::string> token_kind_name_map = {
-	#define Tok(kind, name) {TokenKind::kind, name},
+constexpr std::string_view token_kind_names[] = {
+	#define Tok(kind, name) name,
 		TOKEN_TYPES_LIST
 	#undef Tok
 };
 
-auto name_from_kind(TokenKind kind) -> std::string {
-	For(token_kind_name_map) {
-		if (it.first == kind) {
-			return it.second;
-		}
+constexpr TokenKind token_kinds[] = {
+	#define Tok(kind, name) TokenKind::kind,
+		TOKEN_TYPES_LIST
+	#undef Tok
+};
+
+constexpr size TOKEN_KIND_COUNT = sizeof(token_kinds) / sizeof(token_kinds[0]);
+
+/**
+ * Keywords are the spellings concat_word can produce, everything in the
+ * group, instruction and type ranges minus the unnamed range markers.
+ */
+constexpr auto is_keyword(size i) -> bool {
+	auto kind = token_kinds[i];
+
+	if (token_kind_names[i].empty()) return false;
+
+	return (TokenKind::GROUP_START < kind && kind < TokenKind::GROUP_END)
+		|| (TokenKind::INSTRUCTION_START < kind && kind < TokenKind::INSTRUCTION_END)
+		|| (TokenKind::TYPE_START < kind && kind < TokenKind::TYPE_END);
+}
+
+constexpr size KEYWORD_TABLE_SIZE = 128;
+
+constexpr auto keyword_hash(std::string_view str, u32 seed) -> u32 {
+	u32 hash = seed;
+	for (auto c : str) {
+		hash = (hash ^ (u8)c) * 16777619u;
 	}
-	return "IDENT_LITERAL";
+	return (hash ^ (hash >> 15)) & (KEYWORD_TABLE_SIZE - 1);
 }
 
-auto kind_from_name(std::string name) -> TokenKind {
-	For(token_kind_name_map) {
-		if (it.second == name) {
-			return it.first;
+// Note: Walks seeds until every keyword lands in its own slot, done once at compile time
+constexpr auto find_keyword_seed() -> u32 {
+	for (u32 seed = 2166136261u;; seed++) {
+		bool used[KEYWORD_TABLE_SIZE] = {};
+		bool collision = false;
+
+		for (size i = 0; i < TOKEN_KIND_COUNT && !collision; i++) {
+			if (!is_keyword(i)) continue;
+
+			auto slot = keyword_hash(token_kind_names[i], seed);
+			collision  = used[slot];
+			used[slot] = true;
 		}
+
+		if (!collision) return seed;
+	}
+}
+
+constexpr u32 KEYWORD_SEED = find_keyword_seed();
+
+struct KeywordSlot {
+	std::string_view name;
+	TokenKind kind = TokenKind::IDENT_LITERAL;
+};
+
+struct KeywordTable {
+	KeywordSlot slots[KEYWORD_TABLE_SIZE];
+};
+
+constexpr auto build_keyword_table() -> KeywordTable {
+	KeywordTable table;
+
+	for (size i = 0; i < TOKEN_KIND_COUNT; i++) {
+		if (!is_keyword(i)) continue;
+
+		auto& slot = table.slots[keyword_hash(token_kind_names[i], KEYWORD_SEED)];
+		slot.name = token_kind_names[i];
+		slot.kind = token_kinds[i];
+	}
+	return table;
+}
+
+constexpr KeywordTable keyword_table = build_keyword_table();
+
+static_assert(keyword_table.slots[keyword_hash("ADD", KEYWORD_SEED)].kind == TokenKind::ADD);
+static_assert(keyword_table.slots[keyword_hash("i64", KEYWORD_SEED)].kind == TokenKind::I64);
+
+auto name_from_kind(TokenKind kind) -> std::string_view {
+	return token_kind_names[(u8)kind];
+}
+
+auto kind_from_name(std::string_view name) -> TokenKind {
+	auto& slot = keyword_table.slots[keyword_hash(name, KEYWORD_SEED)];
+
+	if (slot.name == name) {
+		return slot.kind;
 	}
 	return TokenKind::IDENT_LITERAL;
 }
@@ -0,0 +1,166 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <util/Arena.hh>
+
+#include <cstdlib>
+
+namespace hive::ir {
+
+static auto align_up(uintptr_t value, size align) -> uintptr_t {
+	return (value + align - 1) & ~(uintptr_t)(align - 1);
+}
+
+Arena::Arena(size chunk_size) : chunk_size(chunk_size) {}
+
+Arena::~Arena() {
+	release();
+}
+
+auto Arena::alloc(size bytes, size align) -> void* {
+	auto ptr = (char*)align_up((uintptr_t)cursor, align);
+
+	if (!cursor || ptr + bytes > limit) {
+		grow(bytes, align);
+		ptr = (char*)align_up((uintptr_t)cursor, align);
+	}
+
+	cursor = ptr + bytes;
+	counters.bytes_used  += bytes;
+	counters.allocations += 1;
+	return ptr;
+}
+
+auto Arena::grow(size bytes, size align) -> void {
+	size capacity = chunk_size;
+
+	// Note: Oversized requests get a chunk of their own so we never split one across chunks
+	if (bytes + align > capacity) {
+		capacity = bytes + align;
+	}
+
+	Chunk* chunk;
+
+	if (spare && capacity == chunk_size) {
+		chunk = spare;
+		spare = spare->next;
+		spare_count--;
+	} else {
+		chunk = (Chunk*)std::malloc(sizeof(Chunk) + capacity);
+	}
+
+	if (!chunk) {
+		Panic("Arena is unable to allocate a new chunk")
+	}
+
+	chunk->next     = head;
+	chunk->capacity = capacity;
+	head = chunk;
+
+	cursor = (char*)(chunk + 1);
+	limit  = cursor + capacity;
+
+	counters.bytes_reserved += sizeof(Chunk) + capacity;
+	counters.chunks         += 1;
+}
+
+auto Arena::own(void* object, void (*destroy)(void*)) -> void {
+	auto cleanup = (Cleanup*)alloc(sizeof(Cleanup), alignof(Cleanup));
+	cleanup->next    = cleanups;
+	cleanup->object  = object;
+	cleanup->destroy = destroy;
+	cleanups = cleanup;
+}
+
+auto Arena::adopt(Arena& other) -> void {
+	if (!other.head) return;
+
+	auto tail = other.head;
+	while (tail->next) tail = tail->next;
+
+	// Note: Adopted chunks go behind our current one so we keep bumping where we left off
+	if (head) {
+		tail->next = head->next;
+		head->next = other.head;
+	} else {
+		head   = other.head;
+		cursor = other.cursor;
+		limit  = other.limit;
+	}
+
+	if (other.cleanups) {
+		auto last = other.cleanups;
+		while (last->next) last = last->next;
+		last->next = cleanups;
+		cleanups   = other.cleanups;
+	}
+
+	counters.bytes_used     += other.counters.bytes_used;
+	counters.bytes_reserved += other.counters.bytes_reserved;
+	counters.allocations    += other.counters.allocations;
+	counters.chunks         += other.counters.chunks;
+
+	other.head     = nullptr;
+	other.cleanups = nullptr;
+	other.cursor   = nullptr;
+	other.limit    = nullptr;
+	other.counters = ArenaStats{};
+}
+
+auto Arena::release() -> void {
+	for (auto it = cleanups; it; it = it->next) {
+		it->destroy(it->object);
+	}
+	cleanups = nullptr;
+
+	while (head) {
+		auto next = head->next;
+		std::free(head);
+		head = next;
+	}
+
+	while (spare) {
+		auto next = spare->next;
+		std::free(spare);
+		spare = next;
+	}
+	spare_count = 0;
+
+	cursor   = nullptr;
+	limit    = nullptr;
+	counters = ArenaStats{};
+}
+
+auto Arena::reset() -> void {
+	for (auto it = cleanups; it; it = it->next) {
+		it->destroy(it->object);
+	}
+	cleanups = nullptr;
+
+	// Note: Oversized chunks are not worth keeping, their size was for one request only
+	while (head) {
+		auto next = head->next;
+
+		if (head->capacity == chunk_size && spare_count < MAX_SPARE_CHUNKS) {
+			head->next = spare;
+			spare = head;
+			spare_count++;
+		} else {
+			std::free(head);
+		}
+		head = next;
+	}
+
+	cursor   = nullptr;
+	limit    = nullptr;
+	counters = ArenaStats{};
+}
+
+auto Arena::stats() const -> const ArenaStats& {
+	return counters;
+}
+
+}
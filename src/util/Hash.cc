@@ -0,0 +1,97 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <util/Hash.hh>
+
+#include <bit>
+#include <cstring>
+
+namespace hive::ir {
+
+constexpr u64 PRIME_1 = 0x9E3779B185EBCA87ull;
+constexpr u64 PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr u64 PRIME_3 = 0x165667B19E3779F9ull;
+constexpr u64 PRIME_4 = 0x85EBCA77C2B2AE63ull;
+constexpr u64 PRIME_5 = 0x27D4EB2F165667C5ull;
+
+// Note: Little endian loads, same as the reference on the machines we build for
+static auto read64(const u8* ptr) -> u64 {
+	u64 value;
+	std::memcpy(&value, ptr, sizeof(value));
+	return value;
+}
+
+static auto read32(const u8* ptr) -> u32 {
+	u32 value;
+	std::memcpy(&value, ptr, sizeof(value));
+	return value;
+}
+
+static auto round(u64 acc, u64 input) -> u64 {
+	acc += input * PRIME_2;
+	acc  = std::rotl(acc, 31);
+	return acc * PRIME_1;
+}
+
+static auto merge(u64 acc, u64 value) -> u64 {
+	acc ^= round(0, value);
+	return acc * PRIME_1 + PRIME_4;
+}
+
+auto xxh64(const void* data, size length, u64 seed) -> u64 {
+	auto ptr = (const u8*)data;
+	auto end = ptr + length;
+	u64 hash;
+
+	if (length >= 32) {
+		u64 v1 = seed + PRIME_1 + PRIME_2;
+		u64 v2 = seed + PRIME_2;
+		u64 v3 = seed;
+		u64 v4 = seed - PRIME_1;
+
+		for (; end - ptr >= 32; ptr += 32) {
+			v1 = round(v1, read64(ptr));
+			v2 = round(v2, read64(ptr + 8));
+			v3 = round(v3, read64(ptr + 16));
+			v4 = round(v4, read64(ptr + 24));
+		}
+
+		hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+		hash = merge(hash, v1);
+		hash = merge(hash, v2);
+		hash = merge(hash, v3);
+		hash = merge(hash, v4);
+	} else {
+		hash = seed + PRIME_5;
+	}
+
+	hash += length;
+
+	for (; end - ptr >= 8; ptr += 8) {
+		hash ^= round(0, read64(ptr));
+		hash  = std::rotl(hash, 27) * PRIME_1 + PRIME_4;
+	}
+
+	if (end - ptr >= 4) {
+		hash ^= (u64)read32(ptr) * PRIME_1;
+		hash  = std::rotl(hash, 23) * PRIME_2 + PRIME_3;
+		ptr  += 4;
+	}
+
+	for (; ptr < end; ptr++) {
+		hash ^= *ptr * PRIME_5;
+		hash  = std::rotl(hash, 11) * PRIME_1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= PRIME_2;
+	hash ^= hash >> 29;
+	hash *= PRIME_3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+}
@@ -0,0 +1,56 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <util/Interner.hh>
+
+#include <cstring>
+
+namespace hive::ir {
+
+Interner::Interner() : storage(4 * 1024) {
+	// symbol 0 is reserved for NO_SYMBOL
+	strings.push_back(std::string_view());
+}
+
+auto Interner::intern(std::string_view str) -> Symbol {
+	std::lock_guard guard(lock);
+
+	auto found = symbols.find(str);
+	if (found != symbols.end()) {
+		return found->second;
+	}
+
+	auto bytes = (char*)storage.alloc(str.size(), 1);
+	std::memcpy(bytes, str.data(), str.size());
+
+	auto copy   = std::string_view(bytes, str.size());
+	auto symbol = (Symbol)strings.size();
+
+	strings.push_back(copy);
+	symbols.emplace(copy, symbol);
+	return symbol;
+}
+
+auto Interner::lookup(Symbol symbol) const -> std::string_view {
+	std::lock_guard guard(lock);
+	return strings.at(symbol);
+}
+
+auto Interner::count() const -> size {
+	std::lock_guard guard(lock);
+	return strings.size() - 1;
+}
+
+auto Interner::clear() -> void {
+	std::lock_guard guard(lock);
+
+	storage.reset();
+	symbols.clear();
+	strings.clear();
+	strings.push_back(std::string_view());
+}
+
+}
@@ -0,0 +1,139 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <util/ThreadPool.hh>
+
+#include <utility>
+
+namespace hive::ir {
+
+// Which pool and queue the current thread works for, so submit can tell a worker from an outsider
+static thread_local ThreadPool* current_pool = nullptr;
+static thread_local size current_queue = 0;
+
+ThreadPool::ThreadPool(size threads) {
+	if (threads == 0) {
+		threads = hardware_threads();
+	}
+
+	queues.reserve(threads);
+	for (size i = 0; i < threads; i++) {
+		queues.push_back(std::make_unique<Queue>());
+	}
+
+	workers.reserve(threads);
+	for (size i = 0; i < threads; i++) {
+		workers.emplace_back([this, i] { work(i); });
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard guard(lock);
+		stopping = true;
+	}
+	has_job.notify_all();
+
+	For(workers) {
+		it.join();
+	}
+}
+
+auto ThreadPool::submit(Job job) -> void {
+	size index = current_pool == this ? current_queue : next.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+	pending.fetch_add(1);
+	{
+		std::lock_guard guard(queues[index]->lock);
+		queues[index]->jobs.push_back(std::move(job));
+	}
+	queued.fetch_add(1);
+
+	// Note: Taking the lock orders this against a worker that just saw queued == 0 and is about to sleep
+	{
+		std::lock_guard guard(lock);
+	}
+	has_job.notify_one();
+}
+
+auto ThreadPool::wait() -> void {
+	std::unique_lock guard(lock);
+	is_idle.wait(guard, [this] { return pending.load() == 0; });
+
+	if (error) {
+		auto thrown = std::exchange(error, nullptr);
+		guard.unlock();
+		std::rethrow_exception(thrown);
+	}
+}
+
+auto ThreadPool::thread_count() const -> size {
+	return workers.size();
+}
+
+auto ThreadPool::hardware_threads() -> size {
+	auto count = std::thread::hardware_concurrency();
+	return count ? count : 1;
+}
+
+auto ThreadPool::take(size index, Job& job) -> bool {
+	{
+		auto& own = *queues[index];
+		std::lock_guard guard(own.lock);
+
+		if (!own.jobs.empty()) {
+			job = std::move(own.jobs.back());
+			own.jobs.pop_back();
+			queued.fetch_sub(1);
+			return true;
+		}
+	}
+
+	for (size i = 1; i < queues.size(); i++) {
+		auto& other = *queues[(index + i) % queues.size()];
+		std::lock_guard guard(other.lock);
+
+		if (!other.jobs.empty()) {
+			job = std::move(other.jobs.front());
+			other.jobs.pop_front();
+			queued.fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
+
+auto ThreadPool::work(size index) -> void {
+	current_pool  = this;
+	current_queue = index;
+
+	for (;;) {
+		Job job;
+
+		if (!take(index, job)) {
+			std::unique_lock guard(lock);
+			has_job.wait(guard, [this] { return stopping || queued.load() > 0; });
+
+			if (stopping && queued.load() == 0) return;
+			continue;
+		}
+
+		// Note: Anything a job throws would terminate the process here, wait() hands it to the submitter
+		try {
+			job();
+		} catch (...) {
+			std::lock_guard guard(lock);
+			if (!error) error = std::current_exception();
+		}
+
+		if (pending.fetch_sub(1) == 1) {
+			std::lock_guard guard(lock);
+			is_idle.notify_all();
+		}
+	}
+}
+
+}
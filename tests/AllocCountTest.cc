@@ -0,0 +1,71 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Test.hh"
+
+#include <Compiler.hh>
+
+#include <fmt/core.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+/**
+ * Guards the front end against allocating per node again. operator new is
+ * replaced for this executable only and counts while a parse of a fixed
+ * input runs on one thread. Nodes come from the arena, what is left are
+ * the vectors a label, a call and a data type keep, interned names, the
+ * source and the arena chunks. When a change moves the count on purpose,
+ * update EXPECTED with the count the failure prints.
+ */
+static std::atomic<bool> counting = false;
+static std::atomic<std::size_t> allocations = 0;
+
+// Note: Only the plain forms are replaced, the sized and nothrow ones forward to these
+auto operator new(std::size_t count) -> void* {
+	if (counting.load(std::memory_order_relaxed)) allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (auto ptr = std::malloc(count ? count : 1)) return ptr;
+	throw std::bad_alloc();
+}
+
+auto operator new[](std::size_t count) -> void* { return ::operator new(count); }
+auto operator delete(void* ptr) noexcept -> void { std::free(ptr); }
+auto operator delete[](void* ptr) noexcept -> void { std::free(ptr); }
+auto operator delete(void* ptr, std::size_t) noexcept -> void { std::free(ptr); }
+auto operator delete[](void* ptr, std::size_t) noexcept -> void { std::free(ptr); }
+
+using namespace hive::ir;
+
+static constexpr size LABELS   = 100;
+static constexpr size EXPECTED = 655;
+
+static auto source() -> std::string {
+	std::string text = "#version \"0.0.1\"\n#target linux_x64\n#syslink libc\n\n";
+
+	for (size i = 0; i < LABELS; i++) {
+		text += fmt::format("LABEL label_{}:\n", i);
+		text += "\tADD r1, r2 -> r3\n\tSUBTRACT r3, d1 -> r4\n\tNOT r4 -> r5\n\tDEREF r5 -> r6\n\tSTORE r6 -> r7\n";
+		text += "\td1 { i8 i32 i16 i64 }\n\td2 STATIC \"some string\"\n\tCALL libc.printf d2 r1 r7\n\tRETURN r7\n\n";
+	}
+	return text;
+}
+
+int main() {
+	auto path = test::write_file("alloc.hir", source());
+	Compiler compiler(CompileOptions{1});
+
+	counting = true;
+	auto result = compiler.parse(path.c_str());
+	counting = false;
+
+	test::check(result.ok(), "the fixed input does not parse");
+	test::check(allocations == EXPECTED, fmt::format("parsing the fixed input made {} allocations, expected {}", allocations.load(), EXPECTED));
+
+	return test::result();
+}
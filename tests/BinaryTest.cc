@@ -0,0 +1,134 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Test.hh"
+
+#include <Compiler.hh>
+#include <binary/Binary.hh>
+
+#include <fmt/core.h>
+
+#include <cstring>
+
+using namespace hive::ir;
+
+static constexpr std::string_view SOURCE =
+	"#version \"0.0.1\"\n"
+	"#target linux_x64\n"
+	"\n"
+	"LABEL main:\n"
+	"\td1 STATIC \"hello\"\n"
+	"\td2 { i8 i32 }\n"
+	"\tADD r1, d1 -> r2\n"
+	"\tCALL libc.printf d1 r1 r2\n"
+	"\tRETURN r2\n";
+
+// The binary IR of text, empty when it does not parse
+static auto encode(std::string_view text) -> std::string {
+	Compiler compiler(CompileOptions{1});
+	auto result = compiler.parse(test::write_file("binary.hir", text).c_str());
+	std::string out;
+
+	test::check(result.ok(), fmt::format("'{}' does not parse", text));
+	if (result.ok()) compiler.emit(result.program, EmitKind::BINARY, out);
+	return out;
+}
+
+// Parses bytes as a .hirb, a CompileError comes back in the result and anything else escapes
+static auto decode(Compiler& compiler, std::string_view bytes) -> CompileResult {
+	compiler.reset(CompileOptions{1});
+	return compiler.parse(test::write_file("binary.hirb", bytes).c_str());
+}
+
+static auto round_trip() -> void {
+	auto bytes = encode(SOURCE);
+	Compiler compiler;
+	auto result = decode(compiler, bytes);
+
+	test::check(result.ok(), "binary IR does not read back");
+	if (!result.ok()) return;
+
+	std::string text;
+	compiler.emit(result.program, EmitKind::TEXT, text);
+	test::check(text == SOURCE, fmt::format("binary IR reads back as\n{}", text));
+}
+
+static auto label_names() -> void {
+	std::string source = "#version \"0.0.1\"\n\nLABEL \"hello world\":\n\tRETURN r1\n\nLABEL 0x10:\n\tRETURN r2\n\nLABEL 7:\n\tRETURN r3\n";
+	auto bytes = encode(source);
+	Compiler compiler;
+	auto result = decode(compiler, bytes);
+
+	test::check(result.ok(), "labels named by a string or a number do not read back");
+	if (!result.ok()) return;
+
+	std::string text;
+	compiler.emit(result.program, EmitKind::TEXT, text);
+	test::check(text == source, fmt::format("labels named by a string or a number read back as\n{}", text));
+
+	// the text must parse again, a string name that lost its quotes would not
+	test::check(!encode(text).empty(), "read back labels do not parse");
+}
+
+static auto oversized_label() -> void {
+	auto bytes = encode(SOURCE);
+	if (bytes.empty()) return;
+
+	BinaryHeader header;
+	std::memcpy(&header, bytes.data(), sizeof(header));
+
+	BinaryLabel label;
+	std::memcpy(&label, bytes.data() + header.labels_offset, sizeof(label));
+	label.count = 0xFFFFFFFF;
+	std::memcpy(bytes.data() + header.labels_offset, &label, sizeof(label));
+
+	Compiler compiler;
+	auto result = decode(compiler, bytes);
+	test::check(!result.ok() && result.error->code == ErrorCode::BINARY_ERROR, "a label count past the end of the file is read");
+}
+
+// A varint count of about 2^63 over every position of the body, none of them may get to reserve()
+static auto oversized_counts() -> void {
+	auto bytes = encode(SOURCE);
+	if (bytes.empty()) return;
+
+	BinaryHeader header;
+	std::memcpy(&header, bytes.data(), sizeof(header));
+
+	Compiler compiler;
+	size bad = 0;
+
+	for (size at = header.directives_offset; at < bytes.size(); at++) {
+		auto corrupt = bytes.substr(0, at) + std::string(9, '\xFF') + '\x01' + bytes.substr(at);
+		auto result  = decode(compiler, corrupt);
+
+		if (!result.ok() && result.error->code != ErrorCode::BINARY_ERROR) bad++;
+	}
+	test::check(bad == 0, fmt::format("{} oversized counts fail with something other than a binary error", bad));
+}
+
+static auto truncated() -> void {
+	auto bytes = encode(SOURCE);
+	Compiler compiler;
+	size read = 0;
+
+	for (size length = sizeof(BINARY_MAGIC); length < bytes.size(); length++) {
+		auto result = decode(compiler, std::string_view(bytes).substr(0, length));
+
+		if (result.ok()) read++;
+		else test::check(result.error->code == ErrorCode::BINARY_ERROR, fmt::format("truncated to {} bytes: {}", length, result.error->message));
+	}
+	test::check(read == 0, fmt::format("{} truncated files read without an error", read));
+}
+
+auto main() -> int {
+	round_trip();
+	label_names();
+	oversized_label();
+	oversized_counts();
+	truncated();
+	return test::result();
+}
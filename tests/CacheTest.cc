@@ -0,0 +1,110 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Test.hh"
+
+#include <cache/Cache.hh>
+
+#include <fmt/core.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace hive::ir;
+namespace fs = std::filesystem;
+
+static auto read(const std::string& path) -> std::string {
+	std::ifstream file(path, std::ios::binary);
+	std::stringstream bytes;
+	bytes << file.rdbuf();
+	return bytes.str();
+}
+
+// A temporary left by a writer that died, trim() only removes it when it lists the directory
+static auto stale_temp(const fs::path& dir) -> fs::path {
+	auto path = dir / ".tmp-0-0";
+	std::ofstream(path) << "partial";
+	fs::last_write_time(path, fs::file_time_type::clock::now() - std::chrono::hours(2));
+	return path;
+}
+
+static auto entry_bytes(const fs::path& dir) -> size {
+	size total = 0;
+	For(fs::directory_iterator(dir)) {
+		if (it.path().extension() == ".entry") total += it.file_size();
+	}
+	return total;
+}
+
+static auto round_trip(const fs::path& dir) -> void {
+	Cache cache(dir.string());
+	test::check(!cache.open(), "open failed");
+
+	auto key = Cache::key("source", EmitKind::TEXT);
+	test::check(key == Cache::key("source", EmitKind::TEXT), "keys are not stable");
+	test::check(key != Cache::key("source", EmitKind::BINARY), "the emit kind is not part of the key");
+	test::check(key != Cache::key("source!", EmitKind::TEXT), "the source is not part of the key");
+
+	auto target = (dir / "out.hir").string();
+	test::check(!cache.fetch(key, target.c_str()), "hit on an empty cache");
+
+	cache.store(key, "emitted");
+	test::check(cache.fetch(key, target.c_str()) && read(target) == "emitted", "stored entry does not come back");
+	test::check(cache.hits() == 1 && cache.misses() == 1, "wrong hit and miss counts");
+}
+
+static auto trims_only_after_stores(const fs::path& dir) -> void {
+	auto temp = stale_temp(dir);
+	{
+		Cache cache(dir.string());
+		cache.open();
+		cache.fetch(Cache::key("source", EmitKind::TEXT), (dir / "out.hir").c_str());
+		cache.trim();
+	}
+	test::check(fs::exists(temp), "trim() listed the directory without a store");
+
+	{
+		Cache cache(dir.string());
+		cache.store(Cache::key("other", EmitKind::TEXT), "other");
+		cache.trim();
+	}
+	test::check(!fs::exists(temp), "the first trim() after a store did not list the directory");
+
+	temp = stale_temp(dir);
+	{
+		Cache cache(dir.string());
+		cache.store(Cache::key("third", EmitKind::TEXT), "third");
+		cache.trim();
+	}
+	test::check(fs::exists(temp), "trim() listed the directory while under budget");
+	fs::remove(temp);
+}
+
+static auto evicts_past_budget(const fs::path& dir) -> void {
+	std::string bytes(60, 'x');
+
+	for (size i = 0; i < 4; i++) {
+		Cache cache(dir.string(), 100);
+		cache.open();
+		cache.store(Cache::key(fmt::format("source {}", i), EmitKind::TEXT), bytes);
+		cache.trim();
+		test::check(entry_bytes(dir) <= 100, fmt::format("{} bytes of entries after store {} with a budget of 100", entry_bytes(dir), i));
+	}
+	test::check(entry_bytes(dir) == 60, "evicted more than needed");
+}
+
+int main() {
+	auto root = test::directory();
+	fs::create_directories(root);
+
+	round_trip(root / "round_trip");
+	trims_only_after_stores(root / "round_trip");
+	evicts_past_budget(root / "budget");
+
+	return test::result();
+}
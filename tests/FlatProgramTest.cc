@@ -0,0 +1,73 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Test.hh"
+
+#include <Compiler.hh>
+#include <node/FlatProgram.hh>
+
+#include <fmt/core.h>
+
+using namespace hive::ir;
+
+static constexpr std::string_view HEADER = "#version \"0.0.1\"\n#target linux_x64\n\n";
+
+// Flattens text, returns the error the flattening raised if any. flat points into compiler
+static auto flatten(Compiler& compiler, std::string_view text, FlatProgram& flat) -> std::optional<Diagnostic> {
+	compiler.reset(CompileOptions{1});
+	auto path   = test::write_file("flat.hir", fmt::format("{}{}", HEADER, text));
+	auto result = compiler.parse(path.c_str());
+
+	test::check(result.ok(), fmt::format("'{}' does not parse", text));
+	if (!result.ok()) return result.error;
+
+	try {
+		flat = FlatProgram(result.program);
+	} catch (const CompileError& error) {
+		return error.diagnostic;
+	}
+	return std::nullopt;
+}
+
+static auto labels() -> void {
+	Compiler compiler;
+	FlatProgram flat;
+	auto error = flatten(compiler, "LABEL main:\n\tRETURN r1\n\nLABEL 5:\n\tRETURN r2\n\nLABEL \"x\":\n\tRETURN r3\n", flat);
+
+	test::check(!error, "labels named by a number or a string can not be flattened");
+	if (error) return;
+
+	test::check(flat.labels.size() == 3, "expected three labels");
+	if (flat.labels.size() != 3) return;
+	test::check(flat.labels[0].name == "main", "ident label name");
+	test::check(flat.labels[1].name == "5", "number label name");
+	test::check(flat.labels[2].name == "x", "string label name");
+}
+
+static auto registers() -> void {
+	Compiler compiler;
+	FlatProgram flat;
+	auto last  = FlatProgram::MAX_REGISTER;
+	auto error = flatten(compiler, fmt::format("LABEL main:\n\tADD r{}, d{} -> r1\n", last, last), flat);
+
+	test::check(!error, fmt::format("r{} can not be flattened", last));
+	if (!error && flat.instructions.size() == 1) {
+		auto& inst = flat.instructions[0];
+		test::check(FlatProgram::reg_id(inst.ops[0]) == last && !FlatProgram::is_data(inst.ops[0]), "last virtual register round trip");
+		test::check(FlatProgram::reg_id(inst.ops[1]) == last && FlatProgram::is_data(inst.ops[1]), "last data register round trip");
+	}
+
+	for (size id : {last + 1, (size)1 << 32, (size)-1}) {
+		error = flatten(compiler, fmt::format("LABEL main:\n\tRETURN r{}\n", id), flat);
+		test::check(error && error->code == ErrorCode::NOT_IMPLEMENTED, fmt::format("r{} is not rejected", id));
+	}
+}
+
+int main() {
+	labels();
+	registers();
+	return test::result();
+}
@@ -0,0 +1,75 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Test.hh"
+
+#include <Compiler.hh>
+#include <parse/ModuleState.hh>
+#include <util/Hash.hh>
+
+#include <fmt/core.h>
+
+using namespace hive::ir;
+
+static constexpr std::string_view HEADER = "#version \"0.0.1\"\n#target linux_x64\n\n";
+static constexpr std::string_view BODY   = "LABEL main:\n\tADD r1, r2 -> r3\n\tRETURN r3\n\nLABEL other:\n\tRETURN r1\n";
+
+// An incremental compile that loses its header has to fail the way a full compile does
+static auto missing_version() -> void {
+	auto state  = (test::directory() / "version.state").string();
+	auto source = test::write_file("version.hir", fmt::format("{}{}", HEADER, BODY));
+	std::string out;
+
+	Compiler compiler(CompileOptions{1});
+	test::check(!compiler.emit_incremental(source.c_str(), state.c_str(), out), "first incremental compile fails");
+
+	test::write_file("version.hir", BODY);
+
+	compiler.reset(CompileOptions{1});
+	auto full = compiler.parse(source.c_str());
+
+	compiler.reset(CompileOptions{1});
+	auto error = compiler.emit_incremental(source.c_str(), state.c_str(), out);
+
+	test::check(!full.ok(), "a file without a version directive compiles");
+	test::check(error.has_value(), "an incremental compile reused the first segment of a file without a version directive");
+	if (!full.ok() && error) {
+		test::check(error->code == full.error->code, fmt::format("incremental fails with {}, a full compile with {}", error->code, full.error->code));
+	}
+}
+
+// A state whose hashes are not seeded with this build, as another hir would have written it
+static auto foreign_state() -> void {
+	auto state  = (test::directory() / "foreign.state").string();
+	auto source = test::write_file("foreign.hir", fmt::format("{}{}", HEADER, BODY));
+
+	std::string label = std::string(BODY.substr(0, BODY.find("\nLABEL other") + 1));
+	std::string text  = "STALE\n";
+	u64 count = 1;
+	u64 hash  = xxh64(label, ModuleState::VERSION);
+	u64 length = text.size();
+
+	std::string bytes(ModuleState::MAGIC, sizeof(ModuleState::MAGIC));
+	bytes.append((const char*)&ModuleState::VERSION, sizeof(ModuleState::VERSION));
+	bytes.append((const char*)&count, sizeof(count));
+	bytes.append((const char*)&hash, sizeof(hash));
+	bytes.append((const char*)&length, sizeof(length));
+	bytes.append(text);
+	test::write_file("foreign.state", bytes);
+
+	Compiler compiler(CompileOptions{1});
+	std::string out;
+	auto error = compiler.emit_incremental(source.c_str(), state.c_str(), out);
+
+	test::check(!error, "incremental compile with a foreign state fails");
+	test::check(out.find("STALE") == std::string::npos, "text from a state of another build was spliced in");
+}
+
+auto main() -> int {
+	missing_version();
+	foreign_state();
+	return test::result();
+}
@@ -0,0 +1,44 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Test.hh"
+
+#include <Compiler.hh>
+
+#include <fmt/core.h>
+
+using namespace hive::ir;
+
+// Lex errors have to say where in the source they are, as line:column
+struct BadSource {
+	const char* name;
+	const char* text;
+	const char* where;
+};
+
+static constexpr BadSource SOURCES[] = {
+	{"unterminated string", "#version \"0.0.1\"\n#target linux_x64\n\nLABEL main:\n\td1 STATIC \"abc\n", "@ 5:12"},
+	{"unterminated string at the end", "#version \"0.0.1\"\n#target \"linux", "@ 2:9"},
+	{"invalid character", "#version \"0.0.1\"\n#target linux_x64\n\nLABEL main:\n\tRETURN r1 $\n", "@ 5:12"},
+	{"out of range number", "#version \"0.0.1\"\n#target linux_x64\n\nLABEL main:\n\tRETURN r99999999999999999999\n", "@ 5:9"},
+};
+
+int main() {
+	for (auto& source : SOURCES) {
+		auto path = test::write_file("bad.hir", source.text);
+
+		for (size threads : {1, 4}) {
+			Compiler compiler(CompileOptions{threads});
+			auto error = compiler.parse(path.c_str()).error;
+
+			test::check(error && error->code == ErrorCode::LEX_ERROR, fmt::format("{} -j{}: expected a lex error", source.name, threads));
+			if (!error) continue;
+			test::check(error->message.find(source.where) != std::string::npos, fmt::format("{} -j{}: '{}' does not say {}", source.name, threads, error->message, source.where));
+		}
+	}
+
+	return test::result();
+}
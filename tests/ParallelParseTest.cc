@@ -0,0 +1,62 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Test.hh"
+
+#include <Compiler.hh>
+#include <parse/ParallelParse.hh>
+
+#include <fmt/core.h>
+
+#include <string>
+
+using namespace hive::ir;
+
+/**
+ * Splitting a file across threads has to give the same program as parsing
+ * it on one. The strings here run over several lines that look like LABEL
+ * groups, and take up most of the file so the split points land inside them.
+ */
+static auto source() -> std::string {
+	std::string text = "#version \"0.0.1\"\n#target linux_x64\n#syslink libc\n\n";
+
+	for (size i = 0; text.size() < 4 * ParallelParse::MIN_CHUNK_BYTES; i++) {
+		text += fmt::format("LABEL label_{}:\n\tADD r1, r2 -> r3\n\td{} STATIC \"", i, i % 64);
+		for (size line = 0; line < 16; line++) {
+			text += fmt::format("\nLABEL in_string_{}_{}:\n\tRETURN r1\n", i, line);
+		}
+		text += fmt::format("\"\n\tCALL libc.printf d{} r1\n\tRETURN r3\n\n", i % 64);
+	}
+	return text;
+}
+
+static auto emit(const std::string& path, size threads, std::string& out) -> bool {
+	Compiler compiler(CompileOptions{threads});
+	auto result = compiler.parse(path.c_str());
+
+	test::check(result.ok(), fmt::format("-j{}: {}", threads, result.ok() ? "" : result.error->message));
+	if (!result.ok()) return false;
+
+	auto error = compiler.emit(result.program, EmitKind::TEXT, out);
+	test::check(!error, fmt::format("-j{}: emit failed", threads));
+	return !error;
+}
+
+int main() {
+	auto path = test::write_file("strings.hir", source());
+
+	std::string expected;
+	if (!emit(path, 1, expected)) return test::result();
+	test::check(expected.find("LABEL in_string_0_0:") != std::string::npos, "the string lines are missing from -j1 output");
+
+	for (size threads : {2, 3, 4, 7, 16}) {
+		std::string out;
+		if (!emit(path, threads, out)) continue;
+		test::check(out == expected, fmt::format("-j{} output differs from -j1", threads));
+	}
+
+	return test::result();
+}
@@ -0,0 +1,83 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Test.hh"
+
+#include <Compiler.hh>
+#include <parse/Lex.hh>
+#include <parse/Parse.hh>
+
+#include <fmt/core.h>
+
+using namespace hive::ir;
+
+/**
+ * Operands are separated by exactly one space and instructions are indented
+ * by exactly one tab. Every layout below breaks that once, and has to be a
+ * parse error whether blanks are tokens (TEXT) or trivia (TRIVIA_FREE) and
+ * whether the file is parsed on one thread or split across several.
+ */
+static constexpr std::string_view HEADER = "#version \"0.0.1\"\n#target linux_x64\n\nLABEL main:\n";
+
+struct BadLayout {
+	const char* name;
+	const char* line;
+};
+
+static constexpr BadLayout REJECTED[] = {
+	{"two spaces between operands", "\tADD  r1, r2 -> r3\n"},
+	{"two spaces after a comma", "\tADD r1,  r2 -> r3\n"},
+	{"two spaces before an arrow", "\tADD r1, r2  -> r3\n"},
+	{"tab then space indent", "\t ADD r1, r2 -> r3\n"},
+	{"two tab indent", "\t\tADD r1, r2 -> r3\n"},
+	{"tab between operands", "\tADD\tr1, r2 -> r3\n"},
+	{"two spaces between types", "\td1 { i8  i32 }\n"},
+	{"two spaces before a call argument", "\tCALL libc.printf  d1\n"},
+	{"two spaces after LABEL", "\tRETURN r1\n\nLABEL  other:\n\tRETURN r2\n"},
+};
+
+static auto parse_text(const std::string& path, LexMode mode) -> std::optional<Diagnostic> {
+	Context ctx;
+	try {
+		Lex lex(path.c_str(), mode, &ctx);
+		Parse(&lex).construct();
+	} catch (const CompileError& error) {
+		return error.diagnostic;
+	}
+	return std::nullopt;
+}
+
+static auto parse_compiler(const std::string& path, size threads) -> std::optional<Diagnostic> {
+	Compiler compiler(CompileOptions{threads});
+	return compiler.parse(path.c_str()).error;
+}
+
+static auto expect(const char* name, const std::string& path, bool ok) -> void {
+	auto is_ok = [&](std::optional<Diagnostic> error, const char* how) {
+		if (error && error->code != ErrorCode::PARSE_ERROR) {
+			test::check(false, fmt::format("{} ({}): not a parse error: {}", name, how, error->message));
+			return;
+		}
+		test::check(!error == ok, fmt::format("{} ({}): expected {}", name, how, ok ? "to parse" : "a parse error"));
+	};
+
+	is_ok(parse_text(path, LexMode::TEXT), "text");
+	is_ok(parse_text(path, LexMode::TRIVIA_FREE), "trivia free");
+	is_ok(parse_compiler(path, 1), "-j1");
+	is_ok(parse_compiler(path, 4), "-j4");
+}
+
+int main() {
+	auto good = fmt::format("{}\tADD r1, r2 -> r3\n\td1 {{ i8 i32 }}\n\tCALL libc.printf d1\n", HEADER);
+	expect("single blanks", test::write_file("good.hir", good), true);
+
+	for (auto& layout : REJECTED) {
+		auto path = test::write_file("bad.hir", fmt::format("{}{}", HEADER, layout.line));
+		expect(layout.name, path, false);
+	}
+
+	return test::result();
+}
@@ -0,0 +1,78 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Test.hh"
+
+#include <server/Server.hh>
+
+#include <fmt/core.h>
+
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+using namespace hive::ir;
+
+static constexpr std::string_view SOURCE = "#version \"0.0.1\"\n#target linux_x64\n\nLABEL main:\n\tRETURN r1\n";
+
+// A client that connects and never sends must not keep the only worker from the next one
+static auto silent_client(const std::string& socket, const std::string& source) -> void {
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	std::memcpy(address.sun_path, socket.data(), socket.size());
+
+	int silent = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	test::check(::connect(silent, (sockaddr*)&address, sizeof(address)) == 0, "silent client can not connect");
+
+	auto request = std::async(std::launch::async, [&] {
+		std::vector<const char*> args = {source.c_str()};
+		std::string out;
+		return forward(socket.c_str(), args, out);
+	});
+
+	if (request.wait_for(std::chrono::seconds(Server::IO_TIMEOUT_SECONDS * 3)) != std::future_status::ready) {
+		test::check(false, "a client that never sends holds the only worker");
+		std::fflush(stderr);
+		std::_Exit(test::result());
+	}
+
+	test::check(request.get() == 0, "request after the silent client fails");
+	::close(silent);
+}
+
+static auto too_long(const std::string& socket) -> void {
+	std::string word(Server::MAX_REQUEST_BYTES, 'x');
+	std::vector<const char*> args = {word.c_str()};
+	std::string out;
+
+	test::check(forward(socket.c_str(), args, out) == ErrorCode::IO_ERROR, "a request over MAX_REQUEST_BYTES is not an IO_ERROR");
+}
+
+auto main() -> int {
+	auto source = test::write_file("server.hir", SOURCE);
+	auto socket = (test::directory() / "server.sock").string();
+
+	Server server(socket, 1);
+	std::thread serving([&] { server.run(); });
+
+	// run() binds in the background, wait for a request to go through
+	std::vector<const char*> args = {source.c_str()};
+	std::string out;
+	for (int tries = 0; forward(socket.c_str(), args, out) != 0 && tries < 1000; tries++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+
+	silent_client(socket, source);
+	too_long(socket);
+
+	server.stop();
+	serving.join();
+	return test::result();
+}
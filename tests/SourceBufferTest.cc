@@ -0,0 +1,47 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Test.hh"
+
+#include <Compiler.hh>
+#include <parse/SourceBuffer.hh>
+
+#include <fmt/core.h>
+
+#include <filesystem>
+
+using namespace hive::ir;
+
+// Sparse files, so the 4 GiB ones take no disk space and mapping them reads nothing
+static auto sized_file(std::string_view name, size length) -> std::string {
+	auto path = test::write_file(name, "#version \"0.0.1\"\n");
+	std::filesystem::resize_file(path, length);
+	return path;
+}
+
+int main() {
+	{
+		auto path = sized_file("largest.hir", SourceBuffer::MAX_LENGTH);
+		SourceBuffer source;
+		test::check(source.load(path.c_str()), fmt::format("a source of MAX_LENGTH bytes does not load: {}", source.error));
+		test::check(source.length() == SourceBuffer::MAX_LENGTH, "wrong length for the largest source");
+	}
+
+	auto path = sized_file("huge.hir", SourceBuffer::MAX_LENGTH + 1);
+	{
+		SourceBuffer source;
+		test::check(!source.load(path.c_str()), "a 4 GiB source loads");
+		test::check(source.error.find("4 GiB") != std::string::npos, fmt::format("unexpected error '{}'", source.error));
+	}
+
+	for (size threads : {1, 4}) {
+		Compiler compiler(CompileOptions{threads});
+		auto result = compiler.parse(path.c_str());
+		test::check(!result.ok() && result.error->message.find("4 GiB") != std::string::npos, fmt::format("-j{}: a 4 GiB source is not rejected", threads));
+	}
+
+	return test::result();
+}
@@ -0,0 +1,54 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <fmt/core.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+/**
+ * Just enough for the test executables registered with ctest. A failed
+ * check is printed and counted instead of stopping, so one run reports every
+ * broken case, and main() returns test::result().
+ */
+namespace hive::ir::test {
+
+inline int failures = 0;
+
+inline auto directory() -> std::filesystem::path {
+	return std::filesystem::temp_directory_path() / fmt::format("hir_test_{}", ::getpid());
+}
+
+inline auto check(bool ok, std::string_view what) -> void {
+	if (ok) return;
+	failures++;
+	fmt::print(stderr, "FAILED: {}\n", what);
+}
+
+inline auto result() -> int {
+	std::filesystem::remove_all(directory());
+	if (failures) fmt::print(stderr, "{} check(s) failed\n", failures);
+	return failures == 0 ? 0 : 1;
+}
+
+// Writes text to name in a directory of this process that result() removes, returns the path
+inline auto write_file(std::string_view name, std::string_view text) -> std::string {
+	std::filesystem::create_directories(directory());
+
+	auto path = (directory() / name).string();
+	auto file = std::fopen(path.c_str(), "wb");
+	std::fwrite(text.data(), 1, text.size(), file);
+	std::fclose(file);
+	return path;
+}
+
+}
@@ -0,0 +1,56 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "Test.hh"
+
+#include <util/ThreadPool.hh>
+
+#include <fmt/core.h>
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace hive::ir;
+
+// A job that throws must not take the process down, wait() rethrows it and the other jobs still run
+static auto throwing_job() -> void {
+	ThreadPool pool(4);
+	std::atomic<size> ran = 0;
+
+	for (size i = 0; i < 100; i++) {
+		pool.submit([&, i] {
+			if (i == 50) throw std::runtime_error("job 50");
+			ran++;
+		});
+	}
+
+	bool rethrown = false;
+	try {
+		pool.wait();
+	} catch (const std::runtime_error& error) {
+		rethrown = std::string_view(error.what()) == "job 50";
+	}
+
+	test::check(rethrown, "wait() does not rethrow what a job threw");
+	test::check(ran == 99, fmt::format("{} of 99 jobs ran", ran.load()));
+
+	// the error is handed out once, the pool keeps working
+	ran = 0;
+	pool.submit([&] { ran++; });
+
+	bool clean = true;
+	try {
+		pool.wait();
+	} catch (...) {
+		clean = false;
+	}
+	test::check(clean && ran == 1, "the pool does not recover after a job threw");
+}
+
+auto main() -> int {
+	throwing_job();
+	return test::result();
+}